@@ -0,0 +1,71 @@
+#ifndef __A_H_INCLUDED__
+#define __A_H_INCLUDED__
+
+#include <vector>
+#include <cstddef>
+#include <new>
+#include <algorithm>
+#include <type_traits>
+
+//A Node_Arena hands out the nodes of a pointer based tree from large contiguous chunks, instead of allocating
+//every node with new. Nodes are never freed one by one: release_all frees every chunk at once, so tearing down a
+//tree costs one free per chunk instead of a walk over all of its nodes. The first chunk holds first_chunk_nodes
+//nodes and every following chunk doubles the previous one, up to max_chunk_nodes, so small trees stay small and
+//large ones make few allocations. Nodes must be trivially destructible, since their destructors are never run.
+//(Templates need more visibility than functions, hence why it is defined in the hpp file)
+template <class node>
+class Node_Arena{
+  static_assert(std::is_trivially_destructible<node>::value, "Node_Arena only holds trivially destructible nodes");
+public:
+  Node_Arena(){}
+  Node_Arena(const Node_Arena&) = delete;
+  Node_Arena &operator=(const Node_Arena&) = delete;
+  ~Node_Arena(){this->release_all();}
+
+  //Returns a new node, value initialized (all its fields are zero).
+  node *allocate(){
+    if(this->chunks.empty() || this->used_in_chunk == this->chunk_nodes){
+      this->chunk_nodes = this->chunks.empty() ? first_chunk_nodes : std::min(2*this->chunk_nodes, max_chunk_nodes);
+      this->chunks.push_back(static_cast<node*>(::operator new(this->chunk_nodes*sizeof(node))));
+      this->reserved = this->reserved + this->chunk_nodes;
+      this->used_in_chunk = 0;
+    }
+    node *new_node = new (this->chunks.back() + this->used_in_chunk) node();
+    this->used_in_chunk++;
+    this->allocated_nodes++;
+    return new_node;
+  }
+
+  //Frees every chunk, and with them every node handed out so far.
+  void release_all(){
+    for(std::size_t i = 0; i < this->chunks.size(); i++){
+      ::operator delete(this->chunks[i]);
+    }
+    std::vector<node*>().swap(this->chunks);
+    this->chunk_nodes = 0;
+    this->used_in_chunk = 0;
+    this->reserved = 0;
+    this->allocated_nodes = 0;
+  }
+
+  //Returns the bytes taken by the arena: its chunks (including the nodes not handed out yet) and the chunk list.
+  std::size_t footprint(){
+    return this->reserved*sizeof(node) + this->chunks.capacity()*sizeof(node*);
+  }
+
+  std::size_t allocated(){return this->allocated_nodes;}
+private:
+  static constexpr std::size_t first_chunk_nodes = 256;
+  static constexpr std::size_t max_chunk_nodes = 65536;
+  std::vector<node*> chunks;
+  std::size_t chunk_nodes = 0;
+  std::size_t used_in_chunk = 0;
+  std::size_t reserved = 0;
+  std::size_t allocated_nodes = 0;
+};
+
+//std::min takes its arguments by reference, so the constants need a definition (until C++17 makes them inline).
+template <class node> constexpr std::size_t Node_Arena<node>::first_chunk_nodes;
+template <class node> constexpr std::size_t Node_Arena<node>::max_chunk_nodes;
+
+#endif
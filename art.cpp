@@ -0,0 +1,499 @@
+#include "art.hpp"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+//Returns the byte of the pattern at a given depth. Past the end of the pattern the byte is 0, which
+//acts as the character that ends every key, so that no key is a prefix of another (which is why, just like
+//in the Patricia_Tree, the keys cannot contain the 0 character).
+std::uint8_t pattern_byte(const std::string &pattern, std::size_t depth){
+  if(depth < pattern.size()){
+    return (std::uint8_t)pattern[depth];
+  }
+  return 0;
+}
+
+//Adaptive_Radix_Tree constructor. The tree starts empty, with no root.
+Adaptive_Radix_Tree::Adaptive_Radix_Tree(){
+}
+
+//Returns the header of an inner node, which is the first member of every kind of inner node.
+art_header &Adaptive_Radix_Tree::header_of(art_ref node){
+  switch(this->type_of(node)){
+    case node4_type:
+      return this->nodes4[this->index_of(node)].header;
+    case node16_type:
+      return this->nodes16[this->index_of(node)].header;
+    case node48_type:
+      return this->nodes48[this->index_of(node)].header;
+    default:
+      return this->nodes256[this->index_of(node)].header;
+  }
+}
+
+//Returns the byte of the key of a leaf at a given depth, 0 past its end.
+std::uint8_t Adaptive_Radix_Tree::leaf_byte(art_ref leaf, std::size_t depth){
+  const art_leaf &stored = this->leaves[this->index_of(leaf)];
+  if(depth < stored.key_length){
+    return (std::uint8_t)this->key_arena[stored.key_offset + depth];
+  }
+  return 0;
+}
+
+//Checks if the key of the leaf is the pattern, which is a length check and a memcmp. Since the
+//compressed paths longer than art_max_prefix are skipped without looking at them, this is also
+//what verifies those bytes.
+bool Adaptive_Radix_Tree::is_leaf_the_pattern(art_ref leaf, const std::string &pattern){
+  const art_leaf &stored = this->leaves[this->index_of(leaf)];
+  return stored.key_length == pattern.size() && std::memcmp(this->key_arena.data() + stored.key_offset, pattern.data(), pattern.size()) == 0;
+}
+
+//Returns a leaf below node, by always descending through the first child. Since children are never
+//removed, the first position of the children array of a Node4, Node16 or Node48 is always in use.
+art_ref Adaptive_Radix_Tree::any_leaf(art_ref node){
+  while(this->type_of(node) != leaf_type){
+    switch(this->type_of(node)){
+      case node4_type:
+        node = this->nodes4[this->index_of(node)].children[0];
+        break;
+      case node16_type:
+        node = this->nodes16[this->index_of(node)].children[0];
+        break;
+      case node48_type:
+        node = this->nodes48[this->index_of(node)].children[0];
+        break;
+      default:{
+        const art_node256 &inner = this->nodes256[this->index_of(node)];
+        std::size_t byte = 0;
+        while(inner.children[byte] == no_node){
+          byte++;
+        }
+        node = inner.children[byte];
+      }
+    }
+  }
+  return node;
+}
+
+//Appends the pattern to the key arena and makes a new leaf for it, with its own key in the postings table.
+art_ref Adaptive_Radix_Tree::make_leaf(const std::string &pattern, std::size_t value, int text_index){
+  art_leaf new_leaf;
+  new_leaf.key_offset = this->key_arena.size();
+  new_leaf.key_length = pattern.size();
+  this->key_arena.insert(this->key_arena.end(), pattern.begin(), pattern.end());
+  this->leaves.push_back(new_leaf);
+  this->postings.add_key(value, text_index);
+  return this->make_ref(leaf_type, this->leaves.size() - 1);
+}
+
+//Makes an empty Node4 that skips prefix_length bytes, reusing a free slot if there is one.
+//The bytes of the prefix are written by the caller.
+art_ref Adaptive_Radix_Tree::make_node4(std::size_t prefix_length){
+  art_node4 new_node;
+  new_node.header.prefix_length = prefix_length;
+  new_node.header.children_count = 0;
+  if(!this->free_nodes4.empty()){
+    std::uint32_t index = this->free_nodes4.back();
+    this->free_nodes4.pop_back();
+    this->nodes4[index] = new_node;
+    return this->make_ref(node4_type, index);
+  }
+  this->nodes4.push_back(new_node);
+  return this->make_ref(node4_type, this->nodes4.size() - 1);
+}
+
+//Returns the child of node for a given byte, or no_node if there is none. A Node16 compares the byte
+//against its 16 keys at once, keeping only the matches among the keys in use.
+art_ref Adaptive_Radix_Tree::find_child(art_ref node, std::uint8_t byte){
+  switch(this->type_of(node)){
+    case node4_type:{
+      const art_node4 &inner = this->nodes4[this->index_of(node)];
+      for(std::size_t i = 0; i < inner.header.children_count; i++){
+        if(inner.keys[i] == byte){
+          return inner.children[i];
+        }
+      }
+      return no_node;
+    }
+    case node16_type:{
+      const art_node16 &inner = this->nodes16[this->index_of(node)];
+#ifdef __SSE2__
+      __m128i matches = _mm_cmpeq_epi8(_mm_set1_epi8((char)byte), _mm_loadu_si128((const __m128i*)inner.keys));
+      std::uint32_t mask = _mm_movemask_epi8(matches) & ((1u << inner.header.children_count) - 1);
+      if(mask != 0){
+        return inner.children[__builtin_ctz(mask)];
+      }
+#else
+      for(std::size_t i = 0; i < inner.header.children_count; i++){
+        if(inner.keys[i] == byte){
+          return inner.children[i];
+        }
+      }
+#endif
+      return no_node;
+    }
+    case node48_type:{
+      const art_node48 &inner = this->nodes48[this->index_of(node)];
+      if(inner.child_index[byte] == 0){
+        return no_node;
+      }
+      return inner.children[inner.child_index[byte] - 1];
+    }
+    default:
+      return this->nodes256[this->index_of(node)].children[byte];
+  }
+}
+
+//Replaces the child of node for a given byte, which must exist, by another node (used when a child
+//grows, or becomes a Node4 after a split, and so its reference changes).
+void Adaptive_Radix_Tree::replace_child(art_ref node, std::uint8_t byte, art_ref child){
+  switch(this->type_of(node)){
+    case node4_type:{
+      art_node4 &inner = this->nodes4[this->index_of(node)];
+      for(std::size_t i = 0; i < inner.header.children_count; i++){
+        if(inner.keys[i] == byte){
+          inner.children[i] = child;
+        }
+      }
+      break;
+    }
+    case node16_type:{
+      art_node16 &inner = this->nodes16[this->index_of(node)];
+      for(std::size_t i = 0; i < inner.header.children_count; i++){
+        if(inner.keys[i] == byte){
+          inner.children[i] = child;
+        }
+      }
+      break;
+    }
+    case node48_type:{
+      art_node48 &inner = this->nodes48[this->index_of(node)];
+      inner.children[inner.child_index[byte] - 1] = child;
+      break;
+    }
+    default:
+      this->nodes256[this->index_of(node)].children[byte] = child;
+  }
+}
+
+//Moves a full node to the next kind of node (Node4 -> Node16 -> Node48 -> Node256), and returns the reference
+//of the new node. The slot of the old node is left free for the next node of its kind.
+art_ref Adaptive_Radix_Tree::grow(art_ref node){
+  std::uint32_t index = this->index_of(node);
+  switch(this->type_of(node)){
+    case node4_type:{
+      art_node4 old_node = this->nodes4[index];
+      art_node16 new_node;
+      new_node.header = old_node.header;
+      std::memcpy(new_node.keys, old_node.keys, 4);
+      std::memcpy(new_node.children, old_node.children, 4*sizeof(art_ref));
+      this->free_nodes4.push_back(index);
+      if(!this->free_nodes16.empty()){
+        std::uint32_t free_index = this->free_nodes16.back();
+        this->free_nodes16.pop_back();
+        this->nodes16[free_index] = new_node;
+        return this->make_ref(node16_type, free_index);
+      }
+      this->nodes16.push_back(new_node);
+      return this->make_ref(node16_type, this->nodes16.size() - 1);
+    }
+    case node16_type:{
+      art_node16 old_node = this->nodes16[index];
+      art_node48 new_node;
+      new_node.header = old_node.header;
+      std::memset(new_node.child_index, 0, 256);
+      for(std::size_t i = 0; i < 16; i++){
+        new_node.child_index[old_node.keys[i]] = i + 1;
+        new_node.children[i] = old_node.children[i];
+      }
+      this->free_nodes16.push_back(index);
+      if(!this->free_nodes48.empty()){
+        std::uint32_t free_index = this->free_nodes48.back();
+        this->free_nodes48.pop_back();
+        this->nodes48[free_index] = new_node;
+        return this->make_ref(node48_type, free_index);
+      }
+      this->nodes48.push_back(new_node);
+      return this->make_ref(node48_type, this->nodes48.size() - 1);
+    }
+    default:{
+      art_node48 old_node = this->nodes48[index];
+      art_node256 new_node;
+      new_node.header = old_node.header;
+      for(std::size_t byte = 0; byte < 256; byte++){
+        new_node.children[byte] = no_node;
+        if(old_node.child_index[byte] != 0){
+          new_node.children[byte] = old_node.children[old_node.child_index[byte] - 1];
+        }
+      }
+      this->free_nodes48.push_back(index);
+      this->nodes256.push_back(new_node);
+      return this->make_ref(node256_type, this->nodes256.size() - 1);
+    }
+  }
+}
+
+//Adds a child to node for a byte that it has no child for, growing the node first if it is full.
+//Returns the reference of the node, which changes if it grew.
+art_ref Adaptive_Radix_Tree::add_child(art_ref node, std::uint8_t byte, art_ref child){
+  std::uint16_t count = this->header_of(node).children_count;
+  if((this->type_of(node) == node4_type && count == 4) || (this->type_of(node) == node16_type && count == 16) || (this->type_of(node) == node48_type && count == 48)){
+    node = this->grow(node);
+  }
+  switch(this->type_of(node)){
+    case node4_type:{
+      art_node4 &inner = this->nodes4[this->index_of(node)];
+      inner.keys[count] = byte;
+      inner.children[count] = child;
+      break;
+    }
+    case node16_type:{
+      art_node16 &inner = this->nodes16[this->index_of(node)];
+      inner.keys[count] = byte;
+      inner.children[count] = child;
+      break;
+    }
+    case node48_type:{
+      art_node48 &inner = this->nodes48[this->index_of(node)];
+      inner.children[count] = child;
+      inner.child_index[byte] = count + 1;
+      break;
+    }
+    default:
+      this->nodes256[this->index_of(node)].children[byte] = child;
+  }
+  this->header_of(node).children_count = count + 1;
+  return node;
+}
+
+//Returns the number of bytes of the compressed path of node that match the pattern from depth on.
+//The first art_max_prefix bytes are stored in the node, the rest are read from any of its leaves.
+std::size_t Adaptive_Radix_Tree::prefix_mismatch(art_ref node, const std::string &pattern, std::size_t depth){
+  const art_header &header = this->header_of(node);
+  std::size_t stored = std::min((std::size_t)header.prefix_length, art_max_prefix);
+  for(std::size_t i = 0; i < stored; i++){
+    if(header.prefix[i] != pattern_byte(pattern, depth + i)){
+      return i;
+    }
+  }
+  if(header.prefix_length > art_max_prefix){
+    art_ref leaf = this->any_leaf(node);
+    for(std::size_t i = art_max_prefix; i < header.prefix_length; i++){
+      if(this->leaf_byte(leaf, depth + i) != pattern_byte(pattern, depth + i)){
+        return i;
+      }
+    }
+  }
+  return header.prefix_length;
+}
+
+//Inserts the pattern in the subtree rooted at node, whose compressed path starts at byte depth of the
+//pattern, and returns the new reference of the subtree (which changes when the node grows or is split).
+//Leaves are only split when a second key reaches them (lazy expansion): a Node4 is made with the
+//bytes that both keys share as its compressed path, and the two leaves as children. When the pattern
+//differs from the compressed path of an inner node, a Node4 is made with the matching part of the path,
+//the node (keeping the rest of its path) and the new leaf as children.
+art_ref Adaptive_Radix_Tree::insert(art_ref node, const std::string &pattern, std::size_t depth, std::size_t value, int text_index){
+  if(node == no_node){
+    return this->make_leaf(pattern, value, text_index);
+  }
+  if(this->type_of(node) == leaf_type){
+    std::size_t longest = std::max((std::size_t)this->leaves[this->index_of(node)].key_length, pattern.size());
+    std::size_t common = depth;
+    while(common <= longest && this->leaf_byte(node, common) == pattern_byte(pattern, common)){
+      common++;
+    }
+    if(common > longest){
+      this->postings.add_value(this->index_of(node), value, text_index);
+      return node;
+    }
+    art_ref new_node = this->make_node4(common - depth);
+    art_header &header = this->header_of(new_node);
+    for(std::size_t i = 0; i < std::min(common - depth, art_max_prefix); i++){
+      header.prefix[i] = pattern_byte(pattern, depth + i);
+    }
+    new_node = this->add_child(new_node, this->leaf_byte(node, common), node);
+    art_ref new_leaf = this->make_leaf(pattern, value, text_index);
+    return this->add_child(new_node, pattern_byte(pattern, common), new_leaf);
+  }
+
+  art_header old_header = this->header_of(node);
+  if(old_header.prefix_length > 0){
+    std::size_t mismatch = this->prefix_mismatch(node, pattern, depth);
+    if(mismatch < old_header.prefix_length){
+      art_ref new_node = this->make_node4(mismatch);
+      std::memcpy(this->header_of(new_node).prefix, old_header.prefix, std::min(mismatch, art_max_prefix));
+      std::uint32_t remaining = old_header.prefix_length - mismatch - 1;
+      std::uint8_t node_byte = 0;
+      art_header &header = this->header_of(node);
+      if(old_header.prefix_length <= art_max_prefix){
+        node_byte = old_header.prefix[mismatch];
+        std::memcpy(header.prefix, old_header.prefix + mismatch + 1, remaining);
+      }else{
+        art_ref leaf = this->any_leaf(node);
+        node_byte = this->leaf_byte(leaf, depth + mismatch);
+        for(std::size_t i = 0; i < std::min((std::size_t)remaining, art_max_prefix); i++){
+          header.prefix[i] = this->leaf_byte(leaf, depth + mismatch + 1 + i);
+        }
+      }
+      header.prefix_length = remaining;
+      new_node = this->add_child(new_node, node_byte, node);
+      art_ref new_leaf = this->make_leaf(pattern, value, text_index);
+      return this->add_child(new_node, pattern_byte(pattern, depth + mismatch), new_leaf);
+    }
+    depth = depth + old_header.prefix_length;
+  }
+
+  std::uint8_t byte = pattern_byte(pattern, depth);
+  art_ref child = this->find_child(node, byte);
+  if(child != no_node){
+    art_ref new_child = this->insert(child, pattern, depth + 1, value, text_index);
+    if(new_child != child){
+      this->replace_child(node, byte, new_child);
+    }
+    return node;
+  }
+  art_ref new_leaf = this->make_leaf(pattern, value, text_index);
+  return this->add_child(node, byte, new_leaf);
+}
+
+//Inserts a pattern, starting from the root.
+void Adaptive_Radix_Tree::insert(const std::string &pattern, std::size_t value, int text_index){
+  this->root = this->insert(this->root, pattern, 0, value, text_index);
+}
+
+//Frees the arrays of the tree.
+void Adaptive_Radix_Tree::delete_data(){
+  std::vector<art_node4>().swap(this->nodes4);
+  std::vector<art_node16>().swap(this->nodes16);
+  std::vector<art_node48>().swap(this->nodes48);
+  std::vector<art_node256>().swap(this->nodes256);
+  std::vector<std::uint32_t>().swap(this->free_nodes4);
+  std::vector<std::uint32_t>().swap(this->free_nodes16);
+  std::vector<std::uint32_t>().swap(this->free_nodes48);
+  std::vector<art_leaf>().swap(this->leaves);
+  this->postings.clear();
+  std::vector<char>().swap(this->key_arena);
+  this->root = no_node;
+}
+
+//Searches for the pattern, returns its leaf or no_node if it is not in the tree. Only the stored bytes of
+//the compressed paths are compared on the way down, the leaf that is reached is compared in full.
+art_ref Adaptive_Radix_Tree::search(const std::string &pattern){
+  art_ref node = this->root;
+  std::size_t depth = 0;
+  while(node != no_node){
+    if(this->type_of(node) == leaf_type){
+      if(this->is_leaf_the_pattern(node, pattern)){
+        return node;
+      }
+      return no_node;
+    }
+    const art_header &header = this->header_of(node);
+    std::size_t stored = std::min((std::size_t)header.prefix_length, art_max_prefix);
+    for(std::size_t i = 0; i < stored; i++){
+      if(header.prefix[i] != pattern_byte(pattern, depth + i)){
+        return no_node;
+      }
+    }
+    depth = depth + header.prefix_length;
+    node = this->find_child(node, pattern_byte(pattern, depth));
+    depth++;
+  }
+  return no_node;
+}
+
+//Finds the depth of the subtree rooted at node, in nodes.
+int Adaptive_Radix_Tree::find_depth(art_ref node){
+  if(node == no_node){
+    return 0;
+  }
+  int depth = 0;
+  switch(this->type_of(node)){
+    case leaf_type:
+      return 1;
+    case node4_type:
+      for(std::size_t i = 0; i < this->nodes4[this->index_of(node)].header.children_count; i++){
+        depth = std::max(depth, this->find_depth(this->nodes4[this->index_of(node)].children[i]));
+      }
+      break;
+    case node16_type:
+      for(std::size_t i = 0; i < this->nodes16[this->index_of(node)].header.children_count; i++){
+        depth = std::max(depth, this->find_depth(this->nodes16[this->index_of(node)].children[i]));
+      }
+      break;
+    case node48_type:
+      for(std::size_t i = 0; i < this->nodes48[this->index_of(node)].header.children_count; i++){
+        depth = std::max(depth, this->find_depth(this->nodes48[this->index_of(node)].children[i]));
+      }
+      break;
+    default:
+      for(std::size_t byte = 0; byte < 256; byte++){
+        depth = std::max(depth, this->find_depth(this->nodes256[this->index_of(node)].children[byte]));
+      }
+  }
+  return 1 + depth;
+}
+
+//Reports whether the pattern is in the tree.
+//If print is enabled prints information pertaining to the values associated
+//to the pattern in the given text.
+bool Adaptive_Radix_Tree::search_report(const std::string &pattern, int text_index, int print){
+  art_ref leaf = this->search(pattern);
+  if(leaf == no_node){
+    return 0;
+  }
+  if(print){
+    std::cout << pattern << " found with " << this->postings.count(this->index_of(leaf), text_index) << " occurences at positions: ";
+    this->postings.print(this->index_of(leaf), text_index);
+    std::cout << std::endl;
+  }
+  return 1;
+}
+
+//Returns the size of the structure, in bytes: the node arrays (including their free slots),
+//the key arena and the postings table.
+std::size_t Adaptive_Radix_Tree::structure_size(){
+  std::size_t size = sizeof(Adaptive_Radix_Tree) + this->name.capacity()*sizeof(char) + this->key_arena.capacity()*sizeof(char);
+  size = size + this->nodes4.capacity()*sizeof(art_node4) + this->nodes16.capacity()*sizeof(art_node16);
+  size = size + this->nodes48.capacity()*sizeof(art_node48) + this->nodes256.capacity()*sizeof(art_node256);
+  size = size + (this->free_nodes4.capacity() + this->free_nodes16.capacity() + this->free_nodes48.capacity())*sizeof(std::uint32_t);
+  size = size + this->leaves.capacity()*sizeof(art_leaf) + this->postings.structure_size();
+  return size;
+}
+
+//Returns all occurences of the pattern, for each text.
+std::vector<std::size_t> Adaptive_Radix_Tree::occurences(const std::string &pattern){
+  art_ref leaf = this->search(pattern);
+  if(leaf == no_node){
+    return std::vector<std::size_t> {0, 0};
+  }
+  return std::vector<std::size_t> {this->postings.count(this->index_of(leaf), 0), this->postings.count(this->index_of(leaf), 1)};
+}
+
+//Simple example of usage.
+void example_1_art(){
+  Adaptive_Radix_Tree *Tree = new Adaptive_Radix_Tree();
+  Tree->insert("hola", 0, 0);
+  Tree->insert("ola", 1, 0);
+  Tree->insert("holograma", 2, 0);
+  Tree->insert("holografia", 3, 0);
+  Tree->insert("ho", 4, 0);
+  Tree->insert("hola", 50, 0);
+
+  Tree->search_report("hola", 0, 1);
+  Tree->search_report("holograma", 0, 1);
+  Tree->search_report("holografia", 0, 1);
+  Tree->search_report("ho", 0, 1);
+  Tree->search_report("hol", 0, 1);
+
+  Tree->delete_data();
+  delete Tree;
+}
+
+//UNCOMMENT MAIN TO TEST EXAMPLES IN STANDALONE FASHION
+// int main(){
+//   example_1_art();
+//   return 0;
+// }
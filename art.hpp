@@ -0,0 +1,119 @@
+#ifndef __ART_H_INCLUDED__
+#define __ART_H_INCLUDED__
+
+#include <string>
+#include <iostream>
+#include <algorithm>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include "postings.hpp"
+
+//Nodes of the Adaptive_Radix_Tree are referred to by 32 bit references (art_ref): the 3 highest bits
+//tell the kind of node (leaf, Node4, Node16, Node48 or Node256) and the rest are its index in the array
+//that holds the nodes of that kind. A reference of 0 means there is no node.
+typedef std::uint32_t art_ref;
+
+//Number of bytes of the compressed path that an inner node stores. Longer paths keep only their length,
+//and their remaining bytes are read from any leaf below the node when they are needed.
+const std::size_t art_max_prefix = 8;
+
+//Every inner node starts with this header: the bytes of the compressed path that the node
+//skips (path compression), and its number of children.
+struct art_header{
+  std::uint32_t prefix_length;
+  std::uint8_t prefix[art_max_prefix];
+  std::uint16_t children_count;
+};
+
+//Inner node with up to 4 children, the key byte of each child is in keys.
+struct art_node4{
+  art_header header;
+  std::uint8_t keys[4];
+  art_ref children[4];
+};
+
+//Inner node with up to 16 children, its keys are compared against a byte at once with SSE2.
+struct art_node16{
+  art_header header;
+  std::uint8_t keys[16];
+  art_ref children[16];
+};
+
+//Inner node with up to 48 children, child_index[byte] holds the position of the child for byte, plus one
+//(0 for a missing child).
+struct art_node48{
+  art_header header;
+  std::uint8_t child_index[256];
+  art_ref children[48];
+};
+
+//Inner node with a child for every byte.
+struct art_node256{
+  art_header header;
+  art_ref children[256];
+};
+
+//A leaf encodes a key in the key arena, with the position at which it starts and its length in bytes.
+//The values of leaf i, for both texts, are kept in the postings table under the key i.
+struct art_leaf{
+  std::uint64_t key_offset;
+  std::uint32_t key_length;
+};
+
+//Adaptive_Radix_Tree class declaration, exposes the same interface as the Patricia_Tree so that
+//it can be used in the experiment templates.
+class Adaptive_Radix_Tree{
+public:
+  static const art_ref no_node = 0;
+  static const std::uint32_t leaf_type = 1;
+  static const std::uint32_t node4_type = 2;
+  static const std::uint32_t node16_type = 3;
+  static const std::uint32_t node48_type = 4;
+  static const std::uint32_t node256_type = 5;
+
+  Adaptive_Radix_Tree();
+  void insert(const std::string &pattern, std::size_t value, int text_index);
+  void delete_data();
+  art_ref search(const std::string &pattern);
+  bool search_report(const std::string &pattern, int text_index, int print);
+  std::string get_name(){return this->name;}
+  std::size_t structure_size();
+  double extra_measurement(){return this->find_depth(this->root);}
+  std::vector<std::size_t> occurences(const std::string &pattern);
+private:
+  art_ref root = no_node;
+  std::vector<art_node4> nodes4;
+  std::vector<art_node16> nodes16;
+  std::vector<art_node48> nodes48;
+  std::vector<art_node256> nodes256;
+  //Slots of the node arrays left free when a node grows to the next kind, reused by later nodes.
+  std::vector<std::uint32_t> free_nodes4;
+  std::vector<std::uint32_t> free_nodes16;
+  std::vector<std::uint32_t> free_nodes48;
+  std::vector<art_leaf> leaves;
+  Postings_Table postings;
+  std::vector<char> key_arena;
+  std::string name = "ART";
+
+  std::uint32_t type_of(art_ref node){return node >> 29;}
+  std::uint32_t index_of(art_ref node){return node & 0x1FFFFFFF;}
+  art_ref make_ref(std::uint32_t type, std::uint32_t index){return (type << 29) | index;}
+  art_header &header_of(art_ref node);
+  std::uint8_t leaf_byte(art_ref leaf, std::size_t depth);
+  bool is_leaf_the_pattern(art_ref leaf, const std::string &pattern);
+  art_ref any_leaf(art_ref node);
+  art_ref make_leaf(const std::string &pattern, std::size_t value, int text_index);
+  art_ref make_node4(std::size_t prefix_length);
+  art_ref find_child(art_ref node, std::uint8_t byte);
+  void replace_child(art_ref node, std::uint8_t byte, art_ref child);
+  art_ref add_child(art_ref node, std::uint8_t byte, art_ref child);
+  art_ref grow(art_ref node);
+  std::size_t prefix_mismatch(art_ref node, const std::string &pattern, std::size_t depth);
+  art_ref insert(art_ref node, const std::string &pattern, std::size_t depth, std::size_t value, int text_index);
+  int find_depth(art_ref node);
+};
+
+std::uint8_t pattern_byte(const std::string &pattern, std::size_t depth);
+
+#endif
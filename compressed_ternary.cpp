@@ -0,0 +1,204 @@
+#include "compressed_ternary.hpp"
+
+//Class constructor, the tree starts empty.
+Compressed_Ternary_Search_Tree::Compressed_Ternary_Search_Tree(){
+}
+
+//Creates the nodes of the characters of the pattern from depth on, which are not in the tree: a chain of nodes with
+//full segments but the last. Returns the first node, the key ends at the last one.
+struct compressed_ternary_node* Compressed_Ternary_Search_Tree::new_chain(const std::string &pattern, std::size_t depth){
+  struct compressed_ternary_node* first = nullptr;
+  struct compressed_ternary_node** node = &first;
+  while(depth < pattern.size()){
+    (*node) = this->node_arena.allocate();
+    (*node)->length = std::min(max_segment_length, pattern.size() - depth);
+    std::memcpy((*node)->segment, pattern.data() + depth, (*node)->length);
+    this->characters = this->characters + (*node)->length;
+    depth = depth + (*node)->length;
+    node = &((*node)->equal_child);
+  }
+  return first;
+}
+
+//Splits the segment of a node after its first length characters, the rest goes to a new node that becomes its
+//equal child, and takes its place as the node where the key of the whole segment ends.
+void Compressed_Ternary_Search_Tree::split(struct compressed_ternary_node* node, std::size_t length){
+  struct compressed_ternary_node* rest = this->node_arena.allocate();
+  rest->length = node->length - length;
+  std::memcpy(rest->segment, node->segment + length, rest->length);
+  rest->equal_child = node->equal_child;
+  rest->is_terminal = node->is_terminal;
+  rest->posting = node->posting;
+  node->length = length;
+  node->equal_child = rest;
+  node->is_terminal = 0;
+}
+
+//Makes the node terminal if it was not, and adds the value to the postings of its key.
+void Compressed_Ternary_Search_Tree::add_value(struct compressed_ternary_node* node, std::size_t value, int text_index){
+  if(!node->is_terminal){
+    node->is_terminal = 1;
+    node->posting = this->postings.add_key();
+  }
+  this->postings.add_value(node->posting, value, text_index);
+}
+
+//Inserts a key with its value. The first character decides the way among the lesser, equal and greater children
+//like in the Ternary_Search_Tree, and then the rest of the segment is matched: if the pattern ends or differs
+//before the end of the segment the node is split there, so that the pattern continues (or ends) at a node boundary.
+//Once the pattern falls off the tree the rest of it is added as a new chain.
+void Compressed_Ternary_Search_Tree::insert(const std::string &pattern, std::size_t value, int text_index){
+  if(pattern.empty()){
+    this->add_value(&this->empty_key, value, text_index);
+    return;
+  }
+  struct compressed_ternary_node** node = &this->root;
+  std::size_t depth = 0;
+  while(1){
+    if((*node) == nullptr){
+      (*node) = this->new_chain(pattern, depth);
+      struct compressed_ternary_node* last = *node;
+      while(last->equal_child != nullptr){
+        last = last->equal_child;
+      }
+      this->add_value(last, value, text_index);
+      return;
+    }
+    unsigned char character = pattern[depth];
+    if(character < (*node)->segment[0]){
+      node = &((*node)->lesser_child);
+    }else if(character > (*node)->segment[0]){
+      node = &((*node)->greater_child);
+    }else{
+      std::size_t matched = 1;
+      while(matched < (*node)->length && depth + matched < pattern.size() && (unsigned char)pattern[depth + matched] == (*node)->segment[matched]){
+        matched++;
+      }
+      if(matched < (*node)->length){
+        this->split(*node, matched);
+      }
+      depth = depth + matched;
+      if(depth == pattern.size()){
+        this->add_value(*node, value, text_index);
+        return;
+      }
+      node = &((*node)->equal_child);
+    }
+  }
+}
+
+//Common interface of the 3 structures. The nodes are released with the chunks of the arena.
+void Compressed_Ternary_Search_Tree::delete_data(){
+  this->node_arena.release_all();
+  this->root = nullptr;
+  this->empty_key.is_terminal = 0;
+  this->characters = 0;
+  this->postings.clear();
+}
+
+//Searches the pattern in the tree, returns the node where it ends if it is a key of the tree, otherwise nullptr.
+//Once the first character of a segment matches, the rest of it is compared with the pattern with a single memcmp.
+struct compressed_ternary_node* Compressed_Ternary_Search_Tree::search(const std::string &pattern){
+  if(pattern.empty()){
+    return this->empty_key.is_terminal ? &this->empty_key : nullptr;
+  }
+  struct compressed_ternary_node* node = this->root;
+  std::size_t depth = 0;
+  while(node != nullptr){
+    unsigned char character = pattern[depth];
+    if(character < node->segment[0]){
+      node = node->lesser_child;
+    }else if(character > node->segment[0]){
+      node = node->greater_child;
+    }else{
+      if(pattern.size() - depth < node->length || std::memcmp(pattern.data() + depth + 1, node->segment + 1, node->length - 1) != 0){
+        return nullptr;
+      }
+      depth = depth + node->length;
+      if(depth == pattern.size()){
+        return node->is_terminal ? node : nullptr;
+      }
+      node = node->equal_child;
+    }
+  }
+  return nullptr;
+}
+
+//Finds the depth of the tree rooted at node, in nodes.
+int Compressed_Ternary_Search_Tree::find_depth(struct compressed_ternary_node* node){
+  if(node != nullptr){
+    int lesser = this->find_depth(node->lesser_child);
+    int equal = this->find_depth(node->equal_child);
+    int greater = this->find_depth(node->greater_child);
+    return 1 + std::max(std::max(lesser,greater),equal);
+  }
+  return 0;
+}
+
+//Returns the number of nodes, the bytes they take and the average number of characters in a node (the number of
+//ternary nodes that each one replaces).
+std::vector<double> Compressed_Ternary_Search_Tree::node_cost(){
+  std::size_t nodes = this->node_arena.allocated();
+  double characters_per_node = nodes == 0 ? 0.0 : (double)this->characters/nodes;
+  return std::vector<double> {(double)nodes, (double)(nodes*sizeof(struct compressed_ternary_node)), characters_per_node};
+}
+
+//Performs a search in the Tree for the pattern and reports if it finds it or not.
+//If print is enabled it gives the values associated with the key for a given text.
+bool Compressed_Ternary_Search_Tree::search_report(const std::string &pattern, int text_index, int print){
+  struct compressed_ternary_node* s = this->search(pattern);
+  if(s == nullptr){
+    return 0;
+  }
+  if(print){
+    std::cout << pattern << " has been found with " << this->postings.count(s->posting, text_index) << " ocurrences at slots ";
+    this->postings.print(s->posting, text_index);
+    std::cout << std::endl;
+  }
+  return 1;
+}
+
+//Returns the total structure size in bytes: the chunks of the node arena (nodes take 40 bytes) and the postings table.
+std::size_t Compressed_Ternary_Search_Tree::structure_size(){
+  std::size_t size = sizeof(Compressed_Ternary_Search_Tree) + this->name.capacity()*sizeof(char) + this->node_arena.footprint();
+  size = size + this->postings.structure_size();
+  return size;
+}
+
+//Returns all occurences of the pattern, for each text.
+std::vector<std::size_t> Compressed_Ternary_Search_Tree::occurences(const std::string &pattern){
+  struct compressed_ternary_node* s = this->search(pattern);
+  if(s == nullptr){
+    return std::vector<std::size_t> {0, 0};
+  }
+  return std::vector<std::size_t> {this->postings.count(s->posting, 0), this->postings.count(s->posting, 1)};
+}
+
+//Simple example of usage, holograma and holografia split the segment of the first one.
+void example_1_compressed_ternary(){
+  Compressed_Ternary_Search_Tree *Tree = new Compressed_Ternary_Search_Tree();
+  Tree->insert("holograma", 0, 0);
+  Tree->insert("holografia", 1, 0);
+  Tree->insert("hola", 2, 0);
+  Tree->insert("ho", 3, 0);
+  Tree->insert("hola", 4, 0);
+  Tree->insert("internacionalizacion", 5, 0);
+
+  Tree->search_report("hola", 0, 1);
+  Tree->search_report("holograma", 0, 1);
+  Tree->search_report("holografia", 0, 1);
+  Tree->search_report("ho", 0, 1);
+  Tree->search_report("internacionalizacion", 0, 1);
+  Tree->search_report("hol", 0, 1);
+  std::vector<double> cost = Tree->node_cost();
+  std::cout << cost[0] << " nodes, " << cost[2] << " characters per node" << std::endl;
+
+  Tree->delete_data();
+  delete Tree;
+}
+
+//UNCOMMENT MAIN TO TEST EXAMPLES IN STANDALONE FASHION
+// int main(){
+//   example_1_compressed_ternary();
+//   return 0;
+// }
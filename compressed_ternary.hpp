@@ -0,0 +1,64 @@
+#ifndef __CT_H_INCLUDED__
+#define __CT_H_INCLUDED__
+
+#include <string>
+#include <iostream>
+#include <algorithm>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include "arena.hpp"
+#include "postings.hpp"
+
+//The longest segment a node can hold, chosen so that a node takes 40 bytes.
+const std::size_t max_segment_length = 10;
+
+//A compressed ternary node replaces a chain of ternary nodes in which every node but the last only has an equal
+//child. It holds the characters of the chain (its segment), inline so that reading them costs no other access:
+//- 3 pointers to children, the lesser and greater children branch on the first character of the segment, and the
+//equal child follows the last one
+//- 1 index to the values of the key that ends with the segment, if it is terminal
+//- the length of the segment and the flag that tells whether a key ends at the node
+//- up to max_segment_length characters
+struct compressed_ternary_node{
+  struct compressed_ternary_node* lesser_child;
+  struct compressed_ternary_node* equal_child;
+  struct compressed_ternary_node* greater_child;
+  std::uint32_t posting;
+  std::uint8_t length;
+  bool is_terminal;
+  unsigned char segment[max_segment_length];
+};
+
+//Compressed_Ternary_Search_Tree class, indicates which methods are public and which are private.
+//A ternary search tree whose chains of nodes with only an equal child are collapsed into a single node. A node is
+//split when an insertion diverges in the middle of its segment, and a search compares the rest of the segment
+//with a single memcmp.
+class Compressed_Ternary_Search_Tree{
+public:
+  Compressed_Ternary_Search_Tree();
+  void insert(const std::string &pattern, std::size_t value, int text_index);
+  struct compressed_ternary_node* search(const std::string &pattern);
+  void delete_data();
+  bool search_report(const std::string &pattern, int text_index, int print);
+  std::string get_name(){return this->name;}
+  std::size_t structure_size();
+  std::vector<double> node_cost();
+  double extra_measurement(){return this->find_depth(this->root);}
+  std::vector<std::size_t> occurences(const std::string &pattern);
+private:
+  struct compressed_ternary_node *root = nullptr;
+  Node_Arena<struct compressed_ternary_node> node_arena;
+  struct compressed_ternary_node empty_key = {nullptr, nullptr, nullptr, 0, 0, 0, {0}};
+  //The values of each key, for both texts.
+  Postings_Table postings;
+  std::size_t characters = 0;
+  std::string name = "TERN_PC";
+
+  int find_depth(struct compressed_ternary_node* node);
+  struct compressed_ternary_node* new_chain(const std::string &pattern, std::size_t depth);
+  void split(struct compressed_ternary_node* node, std::size_t length);
+  void add_value(struct compressed_ternary_node* node, std::size_t value, int text_index);
+};
+
+#endif
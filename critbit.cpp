@@ -0,0 +1,217 @@
+#include "critbit.hpp"
+
+//Crit_Bit_Tree constructor. The tree starts empty, with no root.
+Crit_Bit_Tree::Crit_Bit_Tree(){
+}
+
+//Returns the child of node that the pattern branches to. c is the byte of the pattern that the node
+//inspects (0 past the end of the pattern, just like the 0 character that ends the keys of the
+//Patricia_Tree). other_bits | c is 0xFF exactly when the critical bit of c is set, so adding 1
+//carries into the 9th bit, and shifting right 8 positions gives the direction without a branch.
+int Crit_Bit_Tree::direction(const crit_bit_inner &node, const std::string &pattern){
+  std::uint8_t c = 0;
+  if(node.byte < pattern.size()){
+    c = (std::uint8_t)pattern[node.byte];
+  }
+  return (1 + (node.other_bits | c)) >> 8;
+}
+
+//Walks down the tree following the pattern and returns the leaf that it reaches. If the pattern
+//is in the tree it is that leaf, otherwise the key of the leaf shares the longest prefix
+//with the pattern among all the keys of the tree, which is where its critical bit is.
+crit_bit_index Crit_Bit_Tree::best_leaf(const std::string &pattern){
+  crit_bit_index current = this->root;
+  while(!this->is_leaf(current)){
+    const crit_bit_inner &node = this->inner_nodes[current];
+    current = node.child[this->direction(node, pattern)];
+  }
+  return current;
+}
+
+//Checks if the key of the leaf is the pattern, which is a length check and a memcmp.
+bool Crit_Bit_Tree::is_leaf_the_pattern(crit_bit_index leaf, const std::string &pattern){
+  const crit_bit_leaf &stored = this->leaves[leaf & ~leaf_bit];
+  return stored.key_length == pattern.size() && std::memcmp(this->key_arena.data() + stored.key_offset, pattern.data(), pattern.size()) == 0;
+}
+
+//Returns the first byte at which the key of the leaf and the pattern differ, comparing 8 bytes at a time
+//while both have them. If one is a prefix of the other, that is the byte past the end of the shortest one
+//(where its 0 differs from a character of the other), and if they are equal it is their length.
+std::size_t Crit_Bit_Tree::first_different_byte(crit_bit_index leaf, const std::string &pattern){
+  const crit_bit_leaf &stored = this->leaves[leaf & ~leaf_bit];
+  const char *key = this->key_arena.data() + stored.key_offset;
+  std::size_t smallest_size = std::min((std::size_t)stored.key_length, pattern.size());
+  std::size_t byte = 0;
+  for(; byte + 8 <= smallest_size; byte = byte + 8){
+    std::uint64_t key_word, pattern_word;
+    std::memcpy(&key_word, key + byte, 8);
+    std::memcpy(&pattern_word, pattern.data() + byte, 8);
+    if(key_word != pattern_word){
+      return byte + __builtin_ctzll(key_word ^ pattern_word)/8;
+    }
+  }
+  for(; byte < smallest_size; byte++){
+    if(key[byte] != pattern[byte]){
+      return byte;
+    }
+  }
+  return smallest_size;
+}
+
+//Appends the pattern to the key arena and makes a new leaf for it, with its own key in the postings table.
+crit_bit_index Crit_Bit_Tree::make_leaf(const std::string &pattern, std::size_t value, int text_index){
+  crit_bit_leaf new_leaf;
+  new_leaf.key_offset = this->key_arena.size();
+  new_leaf.key_length = pattern.size();
+  this->key_arena.insert(this->key_arena.end(), pattern.begin(), pattern.end());
+  this->leaves.push_back(new_leaf);
+  this->postings.add_key(value, text_index);
+  return (this->leaves.size() - 1) | leaf_bit;
+}
+
+//Inserts a pattern. First we find the leaf that shares the longest prefix with the pattern and the
+//critical bit at which they differ (the highest differing bit of the first differing byte). If there is
+//none the pattern is already in the tree and the value is added to its leaf. Otherwise a new inner node
+//that tests the critical bit is placed on the path of the pattern, above the first node that tests a later
+//bit, so the nodes on every path keep testing increasing bit positions. The keys cannot contain the 0
+//character, which is the one used past their end.
+void Crit_Bit_Tree::insert(const std::string &pattern, std::size_t value, int text_index){
+  if(this->root == no_node){
+    this->root = this->make_leaf(pattern, value, text_index);
+    return;
+  }
+  crit_bit_index leaf = this->best_leaf(pattern);
+  std::size_t new_byte = this->first_different_byte(leaf, pattern);
+  const crit_bit_leaf &stored = this->leaves[leaf & ~leaf_bit];
+  if(new_byte >= std::max((std::size_t)stored.key_length, pattern.size())){
+    this->postings.add_value(leaf & ~leaf_bit, value, text_index);
+    return;
+  }
+  std::uint8_t key_char = 0;
+  std::uint8_t pattern_char = 0;
+  if(new_byte < stored.key_length){
+    key_char = (std::uint8_t)this->key_arena[stored.key_offset + new_byte];
+  }
+  if(new_byte < pattern.size()){
+    pattern_char = (std::uint8_t)pattern[new_byte];
+  }
+  std::uint32_t critical_bit = 1 << (31 - __builtin_clz((std::uint32_t)(key_char ^ pattern_char)));
+  std::uint8_t other_bits = (std::uint8_t)(~critical_bit & 0xFF);
+  const int new_direction = (1 + (other_bits | pattern_char)) >> 8;
+
+  crit_bit_index parent = no_node;
+  int child_type = 0;
+  crit_bit_index current = this->root;
+  while(!this->is_leaf(current)){
+    const crit_bit_inner &node = this->inner_nodes[current];
+    if(node.byte > new_byte || (node.byte == new_byte && node.other_bits > other_bits)){
+      break;
+    }
+    parent = current;
+    child_type = this->direction(node, pattern);
+    current = node.child[child_type];
+  }
+
+  crit_bit_inner new_node;
+  new_node.byte = new_byte;
+  new_node.other_bits = other_bits;
+  new_node.child[new_direction] = this->make_leaf(pattern, value, text_index);
+  new_node.child[1 - new_direction] = current;
+  this->inner_nodes.push_back(new_node);
+  if(parent == no_node){
+    this->root = this->inner_nodes.size() - 1;
+  }else{
+    this->inner_nodes[parent].child[child_type] = this->inner_nodes.size() - 1;
+  }
+}
+
+//Frees the arrays of the tree.
+void Crit_Bit_Tree::delete_data(){
+  std::vector<crit_bit_inner>().swap(this->inner_nodes);
+  std::vector<crit_bit_leaf>().swap(this->leaves);
+  this->postings.clear();
+  std::vector<char>().swap(this->key_arena);
+  this->root = no_node;
+}
+
+//Searches for the pattern, returns its leaf or no_node if it is not in the tree.
+crit_bit_index Crit_Bit_Tree::search(const std::string &pattern){
+  if(this->root == no_node){
+    return no_node;
+  }
+  crit_bit_index leaf = this->best_leaf(pattern);
+  if(this->is_leaf_the_pattern(leaf, pattern)){
+    return leaf;
+  }
+  return no_node;
+}
+
+//Finds the depth of the subtree rooted at node.
+int Crit_Bit_Tree::find_depth(crit_bit_index node){
+  if(node == no_node){
+    return 0;
+  }
+  if(this->is_leaf(node)){
+    return 1;
+  }
+  return 1 + std::max(this->find_depth(this->inner_nodes[node].child[0]), this->find_depth(this->inner_nodes[node].child[1]));
+}
+
+//Reports whether the pattern is in the tree.
+//If print is enabled prints information pertaining to the values associated
+//to the pattern in the given text.
+bool Crit_Bit_Tree::search_report(const std::string &pattern, int text_index, int print){
+  crit_bit_index leaf = this->search(pattern);
+  if(leaf == no_node){
+    return 0;
+  }
+  if(print){
+    std::cout << pattern << " found with " << this->postings.count(leaf & ~leaf_bit, text_index) << " occurences at positions: ";
+    this->postings.print(leaf & ~leaf_bit, text_index);
+    std::cout << std::endl;
+  }
+  return 1;
+}
+
+//Returns the size of the structure, in bytes: the node arrays, the key arena and the postings table.
+std::size_t Crit_Bit_Tree::structure_size(){
+  std::size_t size = sizeof(Crit_Bit_Tree) + this->name.capacity()*sizeof(char) + this->key_arena.capacity()*sizeof(char);
+  size = size + this->inner_nodes.capacity()*sizeof(crit_bit_inner) + this->leaves.capacity()*sizeof(crit_bit_leaf);
+  size = size + this->postings.structure_size();
+  return size;
+}
+
+//Returns all occurences of the pattern, for each text.
+std::vector<std::size_t> Crit_Bit_Tree::occurences(const std::string &pattern){
+  crit_bit_index leaf = this->search(pattern);
+  if(leaf == no_node){
+    return std::vector<std::size_t> {0, 0};
+  }
+  return std::vector<std::size_t> {this->postings.count(leaf & ~leaf_bit, 0), this->postings.count(leaf & ~leaf_bit, 1)};
+}
+
+//Simple example of usage.
+void example_1_crit_bit(){
+  Crit_Bit_Tree *Tree = new Crit_Bit_Tree();
+  Tree->insert("hola", 0, 0);
+  Tree->insert("ola", 1, 0);
+  Tree->insert("holograma", 2, 0);
+  Tree->insert("holografia", 3, 0);
+  Tree->insert("ho", 4, 0);
+  Tree->insert("hola", 50, 0);
+
+  Tree->search_report("hola", 0, 1);
+  Tree->search_report("holograma", 0, 1);
+  Tree->search_report("holografia", 0, 1);
+  Tree->search_report("ho", 0, 1);
+  Tree->search_report("hol", 0, 1);
+
+  Tree->delete_data();
+  delete Tree;
+}
+
+//UNCOMMENT MAIN TO TEST EXAMPLES IN STANDALONE FASHION
+// int main(){
+//   example_1_crit_bit();
+//   return 0;
+// }
@@ -0,0 +1,66 @@
+#ifndef __CB_H_INCLUDED__
+#define __CB_H_INCLUDED__
+
+#include <string>
+#include <iostream>
+#include <algorithm>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include "postings.hpp"
+
+//Just like in the Patricia_Tree, the nodes of the crit-bit tree live in two arrays and are referred to by
+//32 bit indices, whose highest bit tells whether they refer to a leaf.
+typedef std::uint32_t crit_bit_index;
+
+//An inner node of the crit-bit tree. Instead of relative jumps over the bits of the pattern it stores
+//the absolute position of the byte at which its two subtrees differ (byte) and a mask with every bit of
+//that byte set except the critical one (other_bits). The branch taken by a pattern is computed from its
+//raw characters, see Crit_Bit_Tree::direction.
+struct crit_bit_inner{
+  crit_bit_index child[2];
+  std::uint32_t byte;
+  std::uint8_t other_bits;
+};
+
+//A leaf encodes a key in the key arena, with the position at which it starts and its length in bytes.
+//The values of leaf i, for both texts, are kept in postings[i].
+struct crit_bit_leaf{
+  std::uint64_t key_offset;
+  std::uint32_t key_length;
+};
+
+//Crit_Bit_Tree class declaration, exposes the same interface as the Patricia_Tree so that
+//it can be used in the experiment templates.
+class Crit_Bit_Tree{
+public:
+  static const crit_bit_index no_node = 0xFFFFFFFF;
+  static const crit_bit_index leaf_bit = 0x80000000;
+
+  Crit_Bit_Tree();
+  void insert(const std::string &pattern, std::size_t value, int text_index);
+  void delete_data();
+  crit_bit_index search(const std::string &pattern);
+  bool search_report(const std::string &pattern, int text_index, int print);
+  std::string get_name(){return this->name;}
+  std::size_t structure_size();
+  double extra_measurement(){return this->find_depth(this->root);}
+  std::vector<std::size_t> occurences(const std::string &pattern);
+private:
+  crit_bit_index root = no_node;
+  std::vector<crit_bit_inner> inner_nodes;
+  std::vector<crit_bit_leaf> leaves;
+  Postings_Table postings;
+  std::vector<char> key_arena;
+  std::string name = "CRIT";
+
+  bool is_leaf(crit_bit_index node){return (node & leaf_bit) != 0;}
+  int direction(const crit_bit_inner &node, const std::string &pattern);
+  crit_bit_index best_leaf(const std::string &pattern);
+  bool is_leaf_the_pattern(crit_bit_index leaf, const std::string &pattern);
+  std::size_t first_different_byte(crit_bit_index leaf, const std::string &pattern);
+  crit_bit_index make_leaf(const std::string &pattern, std::size_t value, int text_index);
+  int find_depth(crit_bit_index node);
+};
+
+#endif
@@ -0,0 +1,279 @@
+#include "cuckoo_hash.hpp"
+
+//Cuckoo_Table constructor. We start with 32 buckets (128 slots), all of them empty, and the table
+//only grows when a key cannot be placed, so it usually runs at a load factor above 0.9.
+//Just like in the Hash_Table, entry 0 is the one reported when a key is not found.
+Cuckoo_Table::Cuckoo_Table(){
+  this->bucket_count = 32;
+  this->buckets = new cuckoo_bucket[this->bucket_count]();
+  this->stored_elements = 0;
+  this->rehash_time = 0.0;
+  this->entries.push_back(cuckoo_entry());
+  this->entries[0].hash = 0;
+  this->entries[0].key = "VALUE NOT FOUND";
+  this->entries[0].text_position.push_back(std::vector<std::size_t> {});
+  this->entries[0].text_position.push_back(std::vector<std::size_t> {});
+}
+
+//Returns the load factor of the table.
+double Cuckoo_Table::get_fill(){
+  return this->stored_elements/(double)(this->bucket_count*cuckoo_bucket_width);
+}
+
+//The first bucket of a key is given by the lowest bits of its hash.
+std::size_t Cuckoo_Table::first_bucket(std::size_t hash){
+  return hash & (this->bucket_count - 1);
+}
+
+//The second bucket of a key is its first bucket xored with a mix of the upper bits of its hash,
+//which works as a second hash function. The lowest bit of the mix is set so both buckets are always different.
+std::size_t Cuckoo_Table::second_bucket(std::size_t hash){
+  std::size_t mix = (hash >> 32)*0x9E3779B97F4A7C15ULL;
+  return (this->first_bucket(hash) ^ ((mix >> 32) | 1)) & (this->bucket_count - 1);
+}
+
+//Looks for the pattern in its two buckets, comparing the hash tags first, and returns its slot
+//(bucket*cuckoo_bucket_width + position in the bucket) or bucket_count*cuckoo_bucket_width if it is not there.
+std::size_t Cuckoo_Table::find_entry(const std::string &pattern, std::size_t hash){
+  std::uint32_t hash_tag = hash >> 32;
+  std::size_t candidates[2] = {this->first_bucket(hash), this->second_bucket(hash)};
+  for(int c = 0; c < 2; c++){
+    cuckoo_bucket &bucket = this->buckets[candidates[c]];
+    for(std::size_t i = 0; i < cuckoo_bucket_width; i++){
+      if(bucket.entry[i] != 0 && bucket.hash_tag[i] == hash_tag && this->entries[bucket.entry[i]].hash == hash && this->entries[bucket.entry[i]].key == pattern){
+        return candidates[c]*cuckoo_bucket_width + i;
+      }
+    }
+  }
+  return this->bucket_count*cuckoo_bucket_width;
+}
+
+//Places an entry in the first empty slot of a bucket, returns 0 if the bucket is full.
+bool Cuckoo_Table::place_in_bucket(std::uint32_t entry, std::size_t bucket){
+  for(std::size_t i = 0; i < cuckoo_bucket_width; i++){
+    if(this->buckets[bucket].entry[i] == 0){
+      this->buckets[bucket].entry[i] = entry;
+      this->buckets[bucket].hash_tag[i] = this->entries[entry].hash >> 32;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+//Places an entry, which is known not to be in the table, in one of its buckets. If both are full
+//a kick out path is searched, returns 0 if there is none.
+bool Cuckoo_Table::place_entry(std::uint32_t entry){
+  std::size_t hash = this->entries[entry].hash;
+  if(this->place_in_bucket(entry, this->first_bucket(hash)) || this->place_in_bucket(entry, this->second_bucket(hash))){
+    return 1;
+  }
+  return this->kick_out_path(entry);
+}
+
+//Searches, breadth first, for the shortest sequence of keys that can be moved to their other bucket
+//to make room for the entry: the buckets of the entry are visited first, then the other buckets of the
+//keys in them, and so on, until a bucket with an empty slot is found. The keys in the path are then moved
+//starting from the last one, so every move goes to a slot that was just emptied. A bucket is only visited
+//once (so no key moves twice) and the search gives up after max_search_buckets buckets.
+bool Cuckoo_Table::kick_out_path(std::uint32_t entry){
+  struct search_node{
+    std::size_t bucket;
+    std::size_t parent; //the node whose bucket holds the key that would move to this bucket.
+    std::size_t parent_slot;
+  };
+  std::size_t hash = this->entries[entry].hash;
+  std::size_t root = this->bucket_count*cuckoo_bucket_width; //parent of the buckets of the entry.
+  std::vector<search_node> nodes = {{this->first_bucket(hash), root, 0}, {this->second_bucket(hash), root, 0}};
+  for(std::size_t n = 0; n < nodes.size(); n++){
+    cuckoo_bucket &bucket = this->buckets[nodes[n].bucket];
+    for(std::size_t i = 0; i < cuckoo_bucket_width; i++){
+      if(bucket.entry[i] != 0){
+        continue;
+      }
+      std::size_t node = n;
+      std::size_t slot = i;
+      while(nodes[node].parent != root){
+        cuckoo_bucket &parent = this->buckets[nodes[nodes[node].parent].bucket];
+        this->buckets[nodes[node].bucket].entry[slot] = parent.entry[nodes[node].parent_slot];
+        this->buckets[nodes[node].bucket].hash_tag[slot] = parent.hash_tag[nodes[node].parent_slot];
+        slot = nodes[node].parent_slot;
+        node = nodes[node].parent;
+      }
+      this->buckets[nodes[node].bucket].entry[slot] = entry;
+      this->buckets[nodes[node].bucket].hash_tag[slot] = hash >> 32;
+      return 1;
+    }
+    for(std::size_t i = 0; i < cuckoo_bucket_width && nodes.size() < this->max_search_buckets; i++){
+      std::size_t resident_hash = this->entries[bucket.entry[i]].hash;
+      std::size_t other = this->first_bucket(resident_hash);
+      if(other == nodes[n].bucket){
+        other = this->second_bucket(resident_hash);
+      }
+      bool visited = 0;
+      for(std::size_t v = 0; v < nodes.size() && !visited; v++){
+        visited = nodes[v].bucket == other;
+      }
+      if(!visited){
+        nodes.push_back({other, n, i});
+      }
+    }
+  }
+  return 0;
+}
+
+//Doubles the number of buckets and places every entry again, using their stored hashes. If an entry
+//cannot be placed in the new table, the number of buckets is doubled again. The time spent doing
+//so is accumulated in rehash_time, in milliseconds.
+void Cuckoo_Table::grow(){
+  auto start_time = std::chrono::steady_clock::now();
+  bool placed = 0;
+  while(!placed){
+    delete[] this->buckets;
+    this->bucket_count = 2*this->bucket_count;
+    this->buckets = new cuckoo_bucket[this->bucket_count]();
+    placed = 1;
+    for(std::size_t entry = 1; entry < this->entries.size() && placed; entry++){
+      placed = this->place_entry(entry);
+    }
+  }
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start_time;
+  this->rehash_time = this->rehash_time + elapsed.count();
+}
+
+//Insertion function. If the pattern is not in the table an entry is made for it, with the vectors
+//to store the values per text, and placed in the table, which grows if the entry does not fit.
+void Cuckoo_Table::insert(std::string pattern, std::size_t value, int text_index){
+  std::size_t hash = this->hash_function(pattern);
+  std::size_t slot = this->find_entry(pattern, hash);
+  std::uint32_t entry = 0;
+  if(slot != this->bucket_count*cuckoo_bucket_width){
+    entry = this->buckets[slot/cuckoo_bucket_width].entry[slot%cuckoo_bucket_width];
+  }else{
+    this->entries.push_back(cuckoo_entry());
+    entry = this->entries.size() - 1;
+    this->entries[entry].hash = hash;
+    this->entries[entry].key = pattern;
+    this->entries[entry].text_position.push_back(std::vector<std::size_t> {});
+    this->entries[entry].text_position.push_back(std::vector<std::size_t> {});
+    if(!this->place_entry(entry)){
+      this->grow();
+    }
+    this->stored_elements++;
+  }
+  this->entries[entry].text_position[text_index].push_back(value);
+}
+
+//Deletes the buckets and releases the entries.
+void Cuckoo_Table::delete_data(){
+  delete[] this->buckets;
+  std::vector<cuckoo_entry>().swap(this->entries);
+}
+
+//Searches for the pattern, returns its slot or bucket_count*cuckoo_bucket_width if it is not in the table.
+std::size_t Cuckoo_Table::search(const std::string &pattern){
+  return this->find_entry(pattern, this->hash_function(pattern));
+}
+
+//Returns the key stored at a specified slot.
+std::string Cuckoo_Table::key_in_slot(std::size_t slot){
+  if(slot == this->bucket_count*cuckoo_bucket_width){
+    return this->entries[0].key;
+  }
+  return this->entries[this->buckets[slot/cuckoo_bucket_width].entry[slot%cuckoo_bucket_width]].key;
+}
+
+//Prints all the values stored at a given slot, for a given text.
+void Cuckoo_Table::print_positions(std::size_t slot, int text_index){
+  if(slot == this->bucket_count*cuckoo_bucket_width){
+    return;
+  }
+  cuckoo_entry &entry = this->entries[this->buckets[slot/cuckoo_bucket_width].entry[slot%cuckoo_bucket_width]];
+  for(int i = 0; i < entry.text_position[text_index].size(); i++){
+    std::cout << entry.text_position[text_index][i] << ", ";
+  }
+}
+
+//Reports whether the pattern is in the table.
+//If print is enabled prints information pertaining to the values associated
+//to the pattern in the given text.
+bool Cuckoo_Table::search_report(std::string pattern, int text_index, int print){
+  std::size_t slot = this->search(pattern);
+  if(print){
+    std::cout << pattern << " found in slot " << slot << " with " << this->occurences(pattern)[text_index] << " occurences: ";
+    this->print_positions(slot, text_index);
+    std::cout << std::endl;
+  }
+  return slot != this->bucket_count*cuckoo_bucket_width;
+}
+
+//Returns the size of the structure, in bytes: the buckets and the entries, with their keys and values.
+std::size_t Cuckoo_Table::structure_size(){
+  std::size_t size = sizeof(Cuckoo_Table) + this->name.capacity()*sizeof(char) + this->bucket_count*sizeof(cuckoo_bucket);
+  size = size + this->entries.capacity()*sizeof(cuckoo_entry);
+  for(std::size_t entry = 0; entry < this->entries.size(); entry++){
+    size = size + this->entries[entry].key.capacity();
+    size = size + this->entries[entry].text_position.capacity()*sizeof(std::vector<std::size_t>);
+    size = size + (this->entries[entry].text_position[0].capacity() + this->entries[entry].text_position[1].capacity())*sizeof(std::size_t);
+  }
+  return size;
+}
+
+//Returns all occurences of the pattern, for each text.
+std::vector<std::size_t> Cuckoo_Table::occurences(std::string pattern){
+  std::size_t slot = this->search(pattern);
+  std::uint32_t entry = 0;
+  if(slot != this->bucket_count*cuckoo_bucket_width){
+    entry = this->buckets[slot/cuckoo_bucket_width].entry[slot%cuckoo_bucket_width];
+  }
+  return std::vector<std::size_t> {this->entries[entry].text_position[0].size(), this->entries[entry].text_position[1].size()};
+}
+
+//Returns the average and the maximum number of slots inspected to find each of the stored keys
+//(the slots of the first bucket are inspected before those of the second one), to compare with
+//the probe lengths of the Hash_Table. The maximum can never be more than 2*cuckoo_bucket_width.
+std::vector<double> Cuckoo_Table::probe_length_statistics(){
+  double total = 0.0;
+  double max = 0.0;
+  for(std::size_t bucket = 0; bucket < this->bucket_count; bucket++){
+    for(std::size_t i = 0; i < cuckoo_bucket_width; i++){
+      std::uint32_t entry = this->buckets[bucket].entry[i];
+      if(entry != 0){
+        double probes = i + 1;
+        if(bucket != this->first_bucket(this->entries[entry].hash)){
+          probes = probes + cuckoo_bucket_width;
+        }
+        total = total + probes;
+        max = std::max(max, probes);
+      }
+    }
+  }
+  if(this->stored_elements == 0){
+    return std::vector<double> {0.0, 0.0};
+  }
+  return std::vector<double> {total/this->stored_elements, max};
+}
+
+//Simple example of usage.
+void example_1_cuckoo(){
+  Cuckoo_Table *Table = new Cuckoo_Table();
+  Table->insert("SOME", 0, 0);
+  Table->insert("ABACUS", 4, 0);
+  Table->insert("SOMETHING", 16, 0);
+  Table->insert("B", 50, 0);
+  Table->insert("SOME", 40, 0);
+
+  Table->search_report("SOME",0, 1);
+  Table->search_report("ABACUS",0, 1);
+  Table->search_report("SOMETHING",0, 1);
+  Table->search_report("B",0, 1);
+  Table->search_report("SOMERSET",0, 1);
+
+  Table->delete_data();
+  delete Table;
+}
+
+//UNCOMMENT MAIN TO TEST EXAMPLES IN STANDALONE FASHION
+// int main(){
+//   example_1_cuckoo();
+//   return 0;
+// }
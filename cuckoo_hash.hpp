@@ -0,0 +1,71 @@
+#ifndef __C_H_INCLUDED__
+#define __C_H_INCLUDED__
+
+#include <string>
+#include <iostream>
+#include <functional>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <algorithm>
+
+//Every key stored in a Cuckoo_Table has a cuckoo_entry, with the full value of the hash function
+//(which gives both of its buckets), the key and the values for each text, just like a hash_entry.
+struct cuckoo_entry{
+  std::size_t hash;
+  std::string key;
+  std::vector<std::vector<std::size_t>> text_position;
+};
+
+//A bucket has cuckoo_bucket_width slots, each one holds the index of its entry (0 for an empty slot) and the
+//upper 32 bits of the hash of its key, which are compared before looking at the entry. With 4 slots
+//a bucket takes 32 bytes, half a cache line.
+const std::size_t cuckoo_bucket_width = 4;
+struct cuckoo_bucket{
+  std::uint32_t entry[cuckoo_bucket_width];
+  std::uint32_t hash_tag[cuckoo_bucket_width];
+};
+
+//Cuckoo_Table class declaration, exposes the same interface as the Hash_Table so that it can be used
+//in the experiment templates. A key can only be in one of its two buckets, so a search inspects at
+//most 2*cuckoo_bucket_width slots, no matter how full or clustered the table is.
+class Cuckoo_Table{
+public:
+  Cuckoo_Table();
+  void insert(std::string pattern, std::size_t value, int text_index);
+  std::size_t search(const std::string &pattern);
+  void delete_data();
+  std::string key_in_slot(std::size_t slot);
+  bool search_report(std::string pattern, int text_index, int print);
+  std::string get_name(){return this->name;}
+  std::size_t structure_size();
+  double get_fill();
+  double extra_measurement(){return this->get_fill();}
+  double get_rehash_time(){return this->rehash_time;}
+  std::vector<std::size_t> occurences(std::string pattern);
+  std::vector<double> probe_length_statistics();
+private:
+  cuckoo_bucket *buckets;
+  std::size_t bucket_count; //always a power of 2.
+  std::size_t stored_elements;
+  double rehash_time;
+  std::string name = "CUCKOO";
+  //The breadth first search for a free slot gives up after visiting max_search_buckets buckets,
+  //which makes the insertion fail and the table grow.
+  std::size_t max_search_buckets = 128;
+
+  //The entries are kept in insertion order, entry 0 is the one reported when a key is not found.
+  std::vector<cuckoo_entry> entries;
+
+  std::hash<std::string> hash_function;
+  std::size_t first_bucket(std::size_t hash);
+  std::size_t second_bucket(std::size_t hash);
+  std::size_t find_entry(const std::string &pattern, std::size_t hash);
+  bool place_in_bucket(std::uint32_t entry, std::size_t bucket);
+  bool place_entry(std::uint32_t entry);
+  bool kick_out_path(std::uint32_t entry);
+  void grow();
+  void print_positions(std::size_t slot, int text_index);
+};
+
+#endif
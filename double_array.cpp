@@ -0,0 +1,325 @@
+#include "double_array.hpp"
+
+//Double_Array_Trie constructor. The trie starts empty, the insertions are kept in the loading table
+//until freeze is called (or the trie is built directly from the keys and values of any dictionary with build).
+Double_Array_Trie::Double_Array_Trie(){
+  this->keys = 0;
+  this->states = 0;
+  this->build_time = 0.0;
+  this->first_free = -1;
+}
+
+//Insertions are only possible before the trie is frozen.
+void Double_Array_Trie::insert(const std::string &pattern, std::size_t value, int text_index){
+  if(!this->loading_table.insert(pattern, value, text_index)){
+    std::cout << "THE TRIE IS FROZEN, " << pattern << " WAS NOT INSERTED!!!" << std::endl;
+  }
+}
+
+//Builds the trie with the keys inserted so far.
+void Double_Array_Trie::freeze(){
+  std::vector<std::string> keys;
+  std::vector<std::vector<std::vector<std::size_t>>> key_values;
+  if(this->loading_table.take_contents(keys, key_values)){
+    this->build(keys, key_values);
+  }
+}
+
+//Grows the arrays to hold at least size cells (doubling them, so that the build is amortized linear). The new
+//cells are free, and since they come after every other cell they are appended at the end of the free list.
+void Double_Array_Trie::grow(std::size_t size){
+  std::size_t old_size = this->base.size();
+  if(size <= old_size){
+    return;
+  }
+  size = std::max(size, 2*old_size);
+  this->base.resize(size, 0);
+  this->check.resize(size, -1);
+  this->next_free.resize(size);
+  this->previous_free.resize(size);
+  this->trials.resize(size, 0);
+  for(std::int32_t cell = old_size; cell < (std::int32_t)size; cell++){
+    if(this->first_free == -1){
+      this->first_free = cell;
+      this->next_free[cell] = cell;
+      this->previous_free[cell] = cell;
+    }else{
+      std::int32_t last_free = this->previous_free[this->first_free];
+      this->next_free[last_free] = cell;
+      this->previous_free[cell] = last_free;
+      this->next_free[cell] = this->first_free;
+      this->previous_free[this->first_free] = cell;
+    }
+  }
+}
+
+//Removes a cell from the free list, either because it is about to become a state or because too many bases
+//were tried on it. Cells that are out of the list have -1 as their next cell.
+void Double_Array_Trie::take_cell(std::int32_t cell){
+  if(this->next_free[cell] == -1){
+    return;
+  }
+  if(this->next_free[cell] == cell){
+    this->first_free = -1;
+  }else{
+    this->next_free[this->previous_free[cell]] = this->next_free[cell];
+    this->previous_free[this->next_free[cell]] = this->previous_free[cell];
+    if(this->first_free == cell){
+      this->first_free = this->next_free[cell];
+    }
+  }
+  this->next_free[cell] = -1;
+}
+
+//Finds the smallest base for which every code of a state lands in a free cell. Only bases that put the smallest
+//code in a free cell are tried, walking the free list, and if none fits the codes are placed past the end of the arrays.
+//A free cell on which max_trials bases have failed is left out of the list (it can still be claimed by a code
+//that is not the smallest), otherwise the crowded cells at the front are tried again by every state.
+std::int32_t Double_Array_Trie::find_base(const std::vector<std::int32_t> &codes){
+  std::int32_t cell = this->first_free;
+  while(cell != -1){
+    std::int32_t candidate = cell - codes[0];
+    bool fits = candidate >= 0;
+    for(std::size_t i = 1; i < codes.size() && fits; i++){
+      std::size_t target = candidate + codes[i];
+      fits = target >= this->check.size() || this->check[target] == -1;
+    }
+    if(fits){
+      return candidate;
+    }
+    std::int32_t next = this->next_free[cell];
+    this->trials[cell]++;
+    if(this->trials[cell] == max_trials){
+      this->take_cell(cell);
+    }
+    if(next <= cell){
+      break;
+    }
+    cell = next;
+  }
+  return std::max((std::int32_t)this->base.size() - codes[0], 0);
+}
+
+//Builds the transitions of state, for the keys in [first, last) of sorted_keys, which share their first depth characters.
+//The keys are split by the code of their character at depth (0 if they end there), a base is found for the codes
+//and their states are claimed, then each state that only one key reaches becomes a leaf that keeps the rest
+//of the key in the tail, and the others are built recursively. Since the codes are visited in increasing order
+//the leaves are made in the order of the keys, which is the order of their tails.
+void Double_Array_Trie::build_state(std::int32_t state, std::vector<const std::string*> &sorted_keys, std::size_t first, std::size_t last, std::size_t depth){
+  std::vector<std::int32_t> codes;
+  std::vector<std::size_t> starts;
+  for(std::size_t i = first; i < last;){
+    std::int32_t code = 0;
+    if(depth < sorted_keys[i]->size()){
+      code = (std::uint8_t)(*sorted_keys[i])[depth] + 1;
+    }
+    codes.push_back(code);
+    starts.push_back(i);
+    for(i++; i < last; i++){
+      if((depth < sorted_keys[i]->size() ? (std::uint8_t)(*sorted_keys[i])[depth] + 1 : 0) != code){
+        break;
+      }
+    }
+  }
+  starts.push_back(last);
+
+  std::int32_t new_base = this->find_base(codes);
+  this->grow(new_base + codes.back() + 1);
+  this->base[state] = new_base;
+  for(std::size_t i = 0; i < codes.size(); i++){
+    this->take_cell(new_base + codes[i]);
+    this->check[new_base + codes[i]] = state;
+    this->states++;
+  }
+  for(std::size_t i = 0; i < codes.size(); i++){
+    std::int32_t child = new_base + codes[i];
+    if(starts[i + 1] - starts[i] == 1){
+      const std::string &key = *sorted_keys[starts[i]];
+      this->base[child] = -(std::int32_t)starts[i] - 1;
+      if(codes[i] != 0){
+        this->tail.insert(this->tail.end(), key.begin() + depth + 1, key.end());
+      }
+      this->tail_offsets.push_back(this->tail.size());
+    }else{
+      this->build_state(child, sorted_keys, starts[i], starts[i + 1], depth + 1);
+    }
+  }
+}
+
+//Compiles the trie from the keys of a dictionary (which must be different) and their values for each text. The keys are
+//sorted and numbered in that order, their values are copied to the flat values array and the states are built from
+//the root, state 0. Finally the arrays are cut to the last state, plus 257 free cells past the largest base so that
+//searches never index out of them. The time taken is kept in build_time, in milliseconds.
+void Double_Array_Trie::build(std::vector<std::string> &keys, std::vector<std::vector<std::vector<std::size_t>>> &key_values){
+  auto start_time = std::chrono::steady_clock::now();
+  this->loading_table.release();
+  this->keys = keys.size();
+  std::vector<std::size_t> order(this->keys);
+  for(std::size_t i = 0; i < this->keys; i++){
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(), [&keys](std::size_t a, std::size_t b){
+    return keys[a] < keys[b];
+  });
+  std::vector<const std::string*> sorted_keys(this->keys);
+  this->postings.start(this->keys);
+  for(std::size_t i = 0; i < this->keys; i++){
+    sorted_keys[i] = &keys[order[i]];
+    this->postings.add_key(key_values[order[i]]);
+  }
+
+  this->base.clear();
+  this->check.clear();
+  this->tail.clear();
+  this->tail_offsets.assign(1, 0);
+  this->next_free.clear();
+  this->previous_free.clear();
+  this->trials.clear();
+  this->first_free = -1;
+  this->grow(1);
+  this->take_cell(0);
+  this->check[0] = -2;
+  this->states = 1;
+  if(this->keys > 0){
+    this->build_state(0, sorted_keys, 0, this->keys, 0);
+  }
+
+  std::size_t size = 0;
+  for(std::size_t cell = 0; cell < this->check.size(); cell++){
+    if(this->check[cell] != -1){
+      size = std::max(size, cell + 1);
+      if(this->base[cell] >= 0){
+        size = std::max(size, (std::size_t)this->base[cell] + 257);
+      }
+    }
+  }
+  this->base.resize(size, 0);
+  this->check.resize(size, -1);
+  this->base.shrink_to_fit();
+  this->check.shrink_to_fit();
+  this->tail.shrink_to_fit();
+  this->postings.shrink_to_fit();
+  std::vector<std::int32_t>().swap(this->next_free);
+  std::vector<std::int32_t>().swap(this->previous_free);
+  std::vector<std::uint8_t>().swap(this->trials);
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start_time;
+  this->build_time = elapsed.count();
+}
+
+//Deletes the loading table, if the trie was never frozen, and releases the arrays.
+void Double_Array_Trie::delete_data(){
+  this->loading_table.release();
+  std::vector<std::int32_t>().swap(this->base);
+  std::vector<std::int32_t>().swap(this->check);
+  std::vector<char>().swap(this->tail);
+  std::vector<std::uint32_t>().swap(this->tail_offsets);
+  this->postings.clear();
+  std::vector<std::int32_t>().swap(this->next_free);
+  std::vector<std::int32_t>().swap(this->previous_free);
+  std::vector<std::uint8_t>().swap(this->trials);
+}
+
+//Checks if the tail of the key is the rest of the pattern, from depth on.
+bool Double_Array_Trie::is_tail_the_pattern(std::uint32_t key, const std::string &pattern, std::size_t depth){
+  std::size_t length = this->tail_offsets[key + 1] - this->tail_offsets[key];
+  return pattern.size() - depth == length && std::memcmp(this->tail.data() + this->tail_offsets[key], pattern.data() + depth, length) == 0;
+}
+
+//Searches for the pattern, returns its key number or no_key if it is not in the trie. Each character is a single
+//transition, until the pattern ends (then the transition with code 0 must exist) or a leaf is reached, whose
+//tail is compared with the rest of the pattern.
+std::uint32_t Double_Array_Trie::search(const std::string &pattern){
+  if(this->base.empty()){
+    return no_key;
+  }
+  std::int32_t state = 0;
+  for(std::size_t depth = 0; depth < pattern.size(); depth++){
+    std::int32_t next = this->base[state] + (std::uint8_t)pattern[depth] + 1;
+    if(this->check[next] != state){
+      return no_key;
+    }
+    if(this->base[next] < 0){
+      std::uint32_t key = -this->base[next] - 1;
+      if(this->is_tail_the_pattern(key, pattern, depth + 1)){
+        return key;
+      }
+      return no_key;
+    }
+    state = next;
+  }
+  std::int32_t end = this->base[state];
+  if(this->check[end] != state){
+    return no_key;
+  }
+  return -this->base[end] - 1;
+}
+
+//Returns the fraction of the cells of the arrays that are states.
+double Double_Array_Trie::get_fill(){
+  if(this->base.empty()){
+    return 0.0;
+  }
+  return (double)this->states/this->base.size();
+}
+
+//Reports whether the pattern is in the trie.
+//If print is enabled prints information pertaining to the values associated
+//to the pattern in the given text.
+bool Double_Array_Trie::search_report(const std::string &pattern, int text_index, int print){
+  std::uint32_t key = this->search(pattern);
+  if(key == no_key){
+    return 0;
+  }
+  if(print){
+    std::cout << pattern << " found with " << this->postings.count(key, text_index) << " occurences at positions: ";
+    this->postings.print(key, text_index);
+    std::cout << std::endl;
+  }
+  return 1;
+}
+
+//Returns the size of the structure, in bytes. Includes the loading table if it was never frozen.
+std::size_t Double_Array_Trie::structure_size(){
+  std::size_t size = sizeof(Double_Array_Trie) + this->name.capacity()*sizeof(char);
+  size = size + (this->base.capacity() + this->check.capacity() + this->next_free.capacity() + this->previous_free.capacity())*sizeof(std::int32_t) + this->trials.capacity();
+  size = size + this->tail.capacity()*sizeof(char) + this->tail_offsets.capacity()*sizeof(std::uint32_t);
+  size = size + this->postings.structure_size();
+  return size + this->loading_table.structure_size();
+}
+
+//Returns all occurences of the pattern, for each text.
+std::vector<std::size_t> Double_Array_Trie::occurences(const std::string &pattern){
+  std::uint32_t key = this->search(pattern);
+  if(key == no_key){
+    return std::vector<std::size_t> {0, 0};
+  }
+  return this->postings.counts(key);
+}
+
+//Simple example of usage, the trie is frozen after the insertions.
+void example_1_double_array(){
+  Double_Array_Trie *Trie = new Double_Array_Trie();
+  Trie->insert("hola", 0, 0);
+  Trie->insert("ola", 1, 0);
+  Trie->insert("holograma", 2, 0);
+  Trie->insert("holografia", 3, 0);
+  Trie->insert("ho", 4, 0);
+  Trie->insert("hola", 50, 0);
+  Trie->freeze();
+
+  Trie->search_report("hola", 0, 1);
+  Trie->search_report("holograma", 0, 1);
+  Trie->search_report("holografia", 0, 1);
+  Trie->search_report("ho", 0, 1);
+  Trie->search_report("hol", 0, 1);
+  Trie->search_report("holas", 0, 1);
+
+  Trie->delete_data();
+  delete Trie;
+}
+
+//UNCOMMENT MAIN TO TEST EXAMPLES IN STANDALONE FASHION
+// int main(){
+//   example_1_double_array();
+//   return 0;
+// }
@@ -0,0 +1,65 @@
+#ifndef __DA_H_INCLUDED__
+#define __DA_H_INCLUDED__
+
+#include <string>
+#include <iostream>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <chrono>
+#include "frozen_dictionary.hpp"
+
+//A Double_Array_Trie is an immutable trie compiled from the keys and values of a finished dictionary. Its
+//states are cells of two parallel arrays: from state s, the character with code c leads to state t = base[s] + c,
+//which is only a valid transition if check[t] == s. The code of a character is its byte plus one, code 0 marks
+//the end of a key, so a search does one array index per character of the pattern.
+//Tail compression: as soon as a state is only reached by a single key, it becomes a leaf (a negative base, -key - 1)
+//and the rest of the key is kept in tail, where the tail of key k starts at tail_offsets[k]. The keys are numbered
+//in lexicographic order, which is also the order of their values in the postings.
+class Double_Array_Trie{
+public:
+  static const std::uint32_t no_key = 0xFFFFFFFF;
+
+  Double_Array_Trie();
+  void insert(const std::string &pattern, std::size_t value, int text_index);
+  void freeze();
+  void build(std::vector<std::string> &keys, std::vector<std::vector<std::vector<std::size_t>>> &key_values);
+  std::uint32_t search(const std::string &pattern);
+  void delete_data();
+  bool search_report(const std::string &pattern, int text_index, int print);
+  std::string get_name(){return this->name;}
+  std::size_t structure_size();
+  double get_fill();
+  double extra_measurement(){return this->get_fill();}
+  double get_build_time(){return this->build_time;}
+  std::vector<std::size_t> occurences(const std::string &pattern);
+private:
+  Loading_Table loading_table;
+  std::size_t keys;
+  std::size_t states;
+  std::string name = "DAT";
+  double build_time;
+
+  std::vector<std::int32_t> base;
+  std::vector<std::int32_t> check;
+  std::vector<char> tail;
+  std::vector<std::uint32_t> tail_offsets;
+  Flat_Postings postings;
+
+  //The cells that are still free while the trie is built, in a doubly linked list sorted by position, and the
+  //number of bases that failed on each of them.
+  std::vector<std::int32_t> next_free;
+  std::vector<std::int32_t> previous_free;
+  std::vector<std::uint8_t> trials;
+  static const std::uint8_t max_trials = 32;
+  std::int32_t first_free;
+
+  void grow(std::size_t size);
+  void take_cell(std::int32_t cell);
+  std::int32_t find_base(const std::vector<std::int32_t> &codes);
+  void build_state(std::int32_t state, std::vector<const std::string*> &sorted_keys, std::size_t first, std::size_t last, std::size_t depth);
+  bool is_tail_the_pattern(std::uint32_t key, const std::string &pattern, std::size_t depth);
+};
+
+#endif
@@ -1,6 +1,17 @@
 #include "ternary.hpp"
 #include "patricia.hpp"
 #include "linear_hash.hpp"
+#include "swiss_hash.hpp"
+#include "robin_hood_hash.hpp"
+#include "frozen_hash.hpp"
+#include "cuckoo_hash.hpp"
+#include "critbit.hpp"
+#include "art.hpp"
+#include "hat_trie.hpp"
+#include "double_array.hpp"
+#include "louds.hpp"
+#include "front_coding.hpp"
+#include "compressed_ternary.hpp"
 #include "utility.hpp"
 
 std::random_device rand_dev; //these will produce different sequences everytime
@@ -10,7 +21,94 @@ Output_Manager* random_manager;
 Output_Manager* single_text_manager;
 Output_Manager* similarity_manager;
 
-//This template takes a structure (namely: Patricia_Tree, Ternary_Search_Tree or Hash_Table) and performs
+//Returns the time, in milliseconds, that a structure spent rehashing its entries while it grew.
+//The trees grow one node at a time, so only the Hash_Table and the Cuckoo_Table report it.
+template <class structure> double rehash_time(structure*){
+  return 0.0;
+}
+
+template <class hasher> double rehash_time(Basic_Hash_Table<hasher>* s){
+  return s->get_rehash_time();
+}
+
+double rehash_time(Cuckoo_Table* s){
+  return s->get_rehash_time();
+}
+
+//Gives the statistics of a structure to an output manager. The Hash_Table reports them only when compiled
+//with HASH_TABLE_STATISTICS (see linear_hash.hpp), the Ternary_Search_Trees report the number of nodes at every
+//depth and the cost of their nodes (count, bytes and characters per node, to compare them with the compressed
+//tree), and the other structures report none.
+template <class structure> void print_statistics(structure*, Output_Manager*){
+}
+
+template <class hasher> void print_statistics(Basic_Hash_Table<hasher>* s, Output_Manager* manager){
+#ifdef HASH_TABLE_STATISTICS
+  hash_table_statistics statistics = s->get_statistics();
+  std::vector<std::string> labels = {"hit_probe_lengths", "miss_probe_lengths", "largest_cluster", "rehashes", "rehash_time(ms)", "resize_timestamps(ms)"};
+  std::vector<std::vector<double>> values;
+  values.push_back(std::vector<double>(statistics.hit_probe_lengths.begin(), statistics.hit_probe_lengths.end()));
+  values.push_back(std::vector<double>(statistics.miss_probe_lengths.begin(), statistics.miss_probe_lengths.end()));
+  values.push_back(std::vector<double> {(double)statistics.largest_cluster});
+  values.push_back(std::vector<double> {(double)statistics.rehashes});
+  values.push_back(std::vector<double> {statistics.rehash_time});
+  values.push_back(statistics.resize_timestamps);
+  manager->print_statistics(s->get_name(), labels, values);
+#else
+  (void)s;
+  (void)manager;
+#endif
+}
+
+void print_ternary_statistics(Ternary_Search_Tree* s, Output_Manager* manager){
+  std::vector<std::size_t> distribution = s->depth_distribution();
+  std::vector<std::vector<double>> values = {std::vector<double>(distribution.begin(), distribution.end()), s->node_cost()};
+  manager->print_statistics(s->get_name(), std::vector<std::string> {"depth_distribution", "node_cost"}, values);
+}
+
+void print_statistics(Ternary_Search_Tree* s, Output_Manager* manager){
+  print_ternary_statistics(s, manager);
+}
+
+void print_statistics(Balanced_Ternary_Search_Tree* s, Output_Manager* manager){
+  print_ternary_statistics(s, manager);
+}
+
+void print_statistics(Hybrid_Ternary_Search_Tree* s, Output_Manager* manager){
+  print_ternary_statistics(s, manager);
+}
+
+void print_statistics(Hybrid_Ternary_Search_Tree_2* s, Output_Manager* manager){
+  print_ternary_statistics(s, manager);
+}
+
+void print_statistics(Compressed_Ternary_Search_Tree* s, Output_Manager* manager){
+  std::vector<std::vector<double>> values = {std::vector<double> {s->extra_measurement()}, s->node_cost()};
+  manager->print_statistics(s->get_name(), std::vector<std::string> {"depth", "node_cost"}, values);
+}
+
+//Called once all the words have been inserted in a structure, as part of its construction time.
+//Only the static structures do something here, they are built from the words they were given.
+template <class structure> void finish_insertions(structure*){
+}
+
+void finish_insertions(Frozen_Hash_Table* s){
+  s->freeze();
+}
+
+void finish_insertions(Double_Array_Trie* s){
+  s->freeze();
+}
+
+void finish_insertions(Louds_Trie* s){
+  s->freeze();
+}
+
+template <std::size_t bucket_size> void finish_insertions(Basic_Front_Coded_Dictionary<bucket_size>* s){
+  s->freeze();
+}
+
+//This template takes a structure (namely: Patricia_Tree, Ternary_Search_Tree, Hash_Table or Swiss_Table) and performs
 //a random experiment that consists of inserting all the words in the vector permutation_of_words, then
 //searching all the inserted words in the structure and, finally, searching for words that were not inserted
 //(namely: those contained in the vector words_not_in_the_text). While permutation_of_words contains the same
@@ -20,7 +118,7 @@ Output_Manager* similarity_manager;
 //possible. The *_experiment methods are not further divided, in the same spirit, to avoid introducing additional
 //overhead to testing, and to keep blocks tightly knit.
 template <class structure> void random_experiment(std::vector<std::string> permutation_of_words, std::vector<std::string> words, std::vector<std::size_t> words_per_length, int i, int alphabet_size, int verbose, std::vector<std::string> words_not_in_the_text, std::vector<std::size_t> words_per_length_not_in_text){
-  std::vector<double> data(8, 0.0); //We will store the relevant times/values in this vector
+  std::vector<double> data(10, 0.0); //We will store the relevant times/values in this vector
 
   if(verbose){
     std::cout << "        Inserting generated words:" << std::flush;
@@ -32,6 +130,7 @@ template <class structure> void random_experiment(std::vector<std::string> permu
   for (int i = 0; i < permutation_of_words.size(); i++){
     s->insert(permutation_of_words[i], i, 0);
   }
+  finish_insertions(s);
   auto end_time = std::chrono::steady_clock::now();
   double milli_time = elapsed_time_milli(start_time, end_time);
 
@@ -116,20 +215,28 @@ template <class structure> void random_experiment(std::vector<std::string> permu
   }
   data[6] = s->structure_size();
   data[7] = s->extra_measurement();
+  data[8] = rehash_time(s);
   std::vector<std::vector<double>> data_by_m;
 
   data_by_m.push_back(search_times_by_m);
   data_by_m.push_back(miss_times_by_m);
 
-  //random_manager is an output manager (defined in utility.cpp/hpp) which saves the measurements, computes
-  //averages and then prints them to file accordingly.
-  random_manager->update_values(s->get_name(), data, data_by_m, words_per_length, words_per_length_not_in_text);
+  //The structure is torn down before its values are stored, since the time this takes is measured too.
+  std::string name = s->get_name();
+  print_statistics(s, random_manager);
+  start_time = std::chrono::steady_clock::now();
   s->delete_data();
   delete s;
+  end_time = std::chrono::steady_clock::now();
+  data[9] = elapsed_time_milli(start_time, end_time);
+
+  //random_manager is an output manager (defined in utility.cpp/hpp) which saves the measurements, computes
+  //averages and then prints them to file accordingly.
+  random_manager->update_values(name, data, data_by_m, words_per_length, words_per_length_not_in_text);
 }
 
 //This method generates a random sample of words and a sample of words that are not present
-//in the first sample. It loops random_experiment over the 3 structures, where the words
+//in the first sample. It loops random_experiment over the structures, where the words
 //are inserted and queried for.
 void alphabet_size_vs_size(int alphabet_size, int i, double average_word_length, int iterations, int permutations, int verbose){
   auto start_time_whole = std::chrono::steady_clock::now();
@@ -214,6 +321,118 @@ void alphabet_size_vs_size(int alphabet_size, int i, double average_word_length,
       start_time = std::chrono::steady_clock::now();
       random_experiment<Hash_Table>(words_permutation, words, word_lengths, i , alphabet_size, verbose, words_not_in_the_text, words_per_length_not_in_text);
       end_time = std::chrono::steady_clock::now();
+      if(verbose){
+        std::cout << "      } Took: " << elapsed_time_seconds(elapsed_time_milli(start_time, end_time)) << std::endl;
+        std::cout << "\n          Testing Hash Table with control bytes{" << std::endl;
+      }
+
+      start_time = std::chrono::steady_clock::now();
+      random_experiment<Swiss_Table>(words_permutation, words, word_lengths, i , alphabet_size, verbose, words_not_in_the_text, words_per_length_not_in_text);
+      end_time = std::chrono::steady_clock::now();
+      if(verbose){
+        std::cout << "      } Took: " << elapsed_time_seconds(elapsed_time_milli(start_time, end_time)) << std::endl;
+        std::cout << "\n          Testing Robin Hood Hash Table{" << std::endl;
+      }
+
+      start_time = std::chrono::steady_clock::now();
+      random_experiment<Robin_Hood_Table>(words_permutation, words, word_lengths, i , alphabet_size, verbose, words_not_in_the_text, words_per_length_not_in_text);
+      end_time = std::chrono::steady_clock::now();
+      if(verbose){
+        std::cout << "      } Took: " << elapsed_time_seconds(elapsed_time_milli(start_time, end_time)) << std::endl;
+        std::cout << "\n          Testing Frozen Hash Table (minimal perfect hash){" << std::endl;
+      }
+
+      start_time = std::chrono::steady_clock::now();
+      random_experiment<Frozen_Hash_Table>(words_permutation, words, word_lengths, i , alphabet_size, verbose, words_not_in_the_text, words_per_length_not_in_text);
+      end_time = std::chrono::steady_clock::now();
+      if(verbose){
+        std::cout << "      } Took: " << elapsed_time_seconds(elapsed_time_milli(start_time, end_time)) << std::endl;
+        std::cout << "\n          Testing Bucketized Cuckoo Hash Table{" << std::endl;
+      }
+
+      start_time = std::chrono::steady_clock::now();
+      random_experiment<Cuckoo_Table>(words_permutation, words, word_lengths, i , alphabet_size, verbose, words_not_in_the_text, words_per_length_not_in_text);
+      end_time = std::chrono::steady_clock::now();
+      if(verbose){
+        std::cout << "      } Took: " << elapsed_time_seconds(elapsed_time_milli(start_time, end_time)) << std::endl;
+        std::cout << "\n          Testing Crit-bit Tree{" << std::endl;
+      }
+
+      start_time = std::chrono::steady_clock::now();
+      random_experiment<Crit_Bit_Tree>(words_permutation, words, word_lengths, i , alphabet_size, verbose, words_not_in_the_text, words_per_length_not_in_text);
+      end_time = std::chrono::steady_clock::now();
+      if(verbose){
+        std::cout << "      } Took: " << elapsed_time_seconds(elapsed_time_milli(start_time, end_time)) << std::endl;
+        std::cout << "\n          Testing Adaptive Radix Tree{" << std::endl;
+      }
+
+      start_time = std::chrono::steady_clock::now();
+      random_experiment<Adaptive_Radix_Tree>(words_permutation, words, word_lengths, i , alphabet_size, verbose, words_not_in_the_text, words_per_length_not_in_text);
+      end_time = std::chrono::steady_clock::now();
+      if(verbose){
+        std::cout << "      } Took: " << elapsed_time_seconds(elapsed_time_milli(start_time, end_time)) << std::endl;
+        std::cout << "\n          Testing HAT-trie{" << std::endl;
+      }
+
+      start_time = std::chrono::steady_clock::now();
+      random_experiment<Hat_Trie>(words_permutation, words, word_lengths, i , alphabet_size, verbose, words_not_in_the_text, words_per_length_not_in_text);
+      end_time = std::chrono::steady_clock::now();
+      if(verbose){
+        std::cout << "      } Took: " << elapsed_time_seconds(elapsed_time_milli(start_time, end_time)) << std::endl;
+        std::cout << "\n          Testing Double-array trie (frozen){" << std::endl;
+      }
+
+      start_time = std::chrono::steady_clock::now();
+      random_experiment<Double_Array_Trie>(words_permutation, words, word_lengths, i , alphabet_size, verbose, words_not_in_the_text, words_per_length_not_in_text);
+      end_time = std::chrono::steady_clock::now();
+      if(verbose){
+        std::cout << "      } Took: " << elapsed_time_seconds(elapsed_time_milli(start_time, end_time)) << std::endl;
+        std::cout << "\n          Testing LOUDS trie (frozen, succinct){" << std::endl;
+      }
+
+      start_time = std::chrono::steady_clock::now();
+      random_experiment<Louds_Trie>(words_permutation, words, word_lengths, i , alphabet_size, verbose, words_not_in_the_text, words_per_length_not_in_text);
+      end_time = std::chrono::steady_clock::now();
+      if(verbose){
+        std::cout << "      } Took: " << elapsed_time_seconds(elapsed_time_milli(start_time, end_time)) << std::endl;
+        std::cout << "\n          Testing Front-coded dictionary (frozen, buckets of 16){" << std::endl;
+      }
+
+      start_time = std::chrono::steady_clock::now();
+      random_experiment<Front_Coded_Dictionary>(words_permutation, words, word_lengths, i , alphabet_size, verbose, words_not_in_the_text, words_per_length_not_in_text);
+      end_time = std::chrono::steady_clock::now();
+      if(verbose){
+        std::cout << "      } Took: " << elapsed_time_seconds(elapsed_time_milli(start_time, end_time)) << std::endl;
+        std::cout << "\n          Testing Ternary search tree (treap){" << std::endl;
+      }
+
+      start_time = std::chrono::steady_clock::now();
+      random_experiment<Balanced_Ternary_Search_Tree>(words_permutation, words, word_lengths, i , alphabet_size, verbose, words_not_in_the_text, words_per_length_not_in_text);
+      end_time = std::chrono::steady_clock::now();
+      if(verbose){
+        std::cout << "      } Took: " << elapsed_time_seconds(elapsed_time_milli(start_time, end_time)) << std::endl;
+        std::cout << "\n          Testing Ternary search tree (R root){" << std::endl;
+      }
+
+      start_time = std::chrono::steady_clock::now();
+      random_experiment<Hybrid_Ternary_Search_Tree>(words_permutation, words, word_lengths, i , alphabet_size, verbose, words_not_in_the_text, words_per_length_not_in_text);
+      end_time = std::chrono::steady_clock::now();
+      if(verbose){
+        std::cout << "      } Took: " << elapsed_time_seconds(elapsed_time_milli(start_time, end_time)) << std::endl;
+        std::cout << "\n          Testing Ternary search tree (R^2 root){" << std::endl;
+      }
+
+      start_time = std::chrono::steady_clock::now();
+      random_experiment<Hybrid_Ternary_Search_Tree_2>(words_permutation, words, word_lengths, i , alphabet_size, verbose, words_not_in_the_text, words_per_length_not_in_text);
+      end_time = std::chrono::steady_clock::now();
+      if(verbose){
+        std::cout << "      } Took: " << elapsed_time_seconds(elapsed_time_milli(start_time, end_time)) << std::endl;
+        std::cout << "\n          Testing Ternary search tree (path compressed){" << std::endl;
+      }
+
+      start_time = std::chrono::steady_clock::now();
+      random_experiment<Compressed_Ternary_Search_Tree>(words_permutation, words, word_lengths, i , alphabet_size, verbose, words_not_in_the_text, words_per_length_not_in_text);
+      end_time = std::chrono::steady_clock::now();
       loop_time_end = std::chrono::steady_clock::now();
       if(verbose){
         std::cout << "\n      } Took: " << elapsed_time_seconds(elapsed_time_milli(start_time, end_time)) << std::endl;
@@ -274,6 +493,7 @@ template <class structure> void single_text_experiment(std::size_t max_word_leng
   for(int i = 0; i < t1_permutation.size(); i++){
     T->insert(t1_permutation[i], i, 0);
   }
+  finish_insertions(T);
   auto insert_end = std::chrono::steady_clock::now();
   auto insert_time = elapsed_time_milli(insert_start, insert_end);
   data.push_back(elapsed_time_seconds(insert_time));
@@ -320,12 +540,18 @@ template <class structure> void single_text_experiment(std::size_t max_word_leng
 
   data.push_back(T->structure_size());
   data.push_back(T->extra_measurement());
+  data.push_back(rehash_time(T));
   data_by_m.push_back(search_times_by_m);
   data_by_m.push_back(miss_times_by_m);
-  //We feed the data to the text manager, delete the structure data and return.
-  single_text_manager->update_values(T->get_name(), data, data_by_m, words_per_length_in_text, words_per_length_not_in_text);
+  //We delete the structure data, measuring the time it takes, feed the data to the text manager and return.
+  std::string name = T->get_name();
+  print_statistics(T, single_text_manager);
+  auto teardown_start = std::chrono::steady_clock::now();
   T->delete_data();
   delete T;
+  auto teardown_end = std::chrono::steady_clock::now();
+  data.push_back(elapsed_time_milli(teardown_start, teardown_end));
+  single_text_manager->update_values(name, data, data_by_m, words_per_length_in_text, words_per_length_not_in_text);
 }
 
 //Performs single_text_experiment for a given set of repetitions (permutations).
@@ -364,6 +590,20 @@ void single_text_experiments(std::vector<std::string> text, int i, int permutati
     single_text_experiment<Patricia_Tree>(max_word_size, t1_permutation, words_per_length_in_text, words_in_the_text, words_per_length_not_in_text, words_not_in_the_text);
     single_text_experiment<Ternary_Search_Tree>(max_word_size, t1_permutation, words_per_length_in_text, words_in_the_text, words_per_length_not_in_text, words_not_in_the_text);
     single_text_experiment<Hash_Table>(max_word_size, t1_permutation, words_per_length_in_text, words_in_the_text, words_per_length_not_in_text, words_not_in_the_text);
+    single_text_experiment<Swiss_Table>(max_word_size, t1_permutation, words_per_length_in_text, words_in_the_text, words_per_length_not_in_text, words_not_in_the_text);
+    single_text_experiment<Robin_Hood_Table>(max_word_size, t1_permutation, words_per_length_in_text, words_in_the_text, words_per_length_not_in_text, words_not_in_the_text);
+    single_text_experiment<Frozen_Hash_Table>(max_word_size, t1_permutation, words_per_length_in_text, words_in_the_text, words_per_length_not_in_text, words_not_in_the_text);
+    single_text_experiment<Cuckoo_Table>(max_word_size, t1_permutation, words_per_length_in_text, words_in_the_text, words_per_length_not_in_text, words_not_in_the_text);
+    single_text_experiment<Crit_Bit_Tree>(max_word_size, t1_permutation, words_per_length_in_text, words_in_the_text, words_per_length_not_in_text, words_not_in_the_text);
+    single_text_experiment<Adaptive_Radix_Tree>(max_word_size, t1_permutation, words_per_length_in_text, words_in_the_text, words_per_length_not_in_text, words_not_in_the_text);
+    single_text_experiment<Hat_Trie>(max_word_size, t1_permutation, words_per_length_in_text, words_in_the_text, words_per_length_not_in_text, words_not_in_the_text);
+    single_text_experiment<Double_Array_Trie>(max_word_size, t1_permutation, words_per_length_in_text, words_in_the_text, words_per_length_not_in_text, words_not_in_the_text);
+    single_text_experiment<Louds_Trie>(max_word_size, t1_permutation, words_per_length_in_text, words_in_the_text, words_per_length_not_in_text, words_not_in_the_text);
+    single_text_experiment<Front_Coded_Dictionary>(max_word_size, t1_permutation, words_per_length_in_text, words_in_the_text, words_per_length_not_in_text, words_not_in_the_text);
+    single_text_experiment<Balanced_Ternary_Search_Tree>(max_word_size, t1_permutation, words_per_length_in_text, words_in_the_text, words_per_length_not_in_text, words_not_in_the_text);
+    single_text_experiment<Hybrid_Ternary_Search_Tree>(max_word_size, t1_permutation, words_per_length_in_text, words_in_the_text, words_per_length_not_in_text, words_not_in_the_text);
+    single_text_experiment<Hybrid_Ternary_Search_Tree_2>(max_word_size, t1_permutation, words_per_length_in_text, words_in_the_text, words_per_length_not_in_text, words_not_in_the_text);
+    single_text_experiment<Compressed_Ternary_Search_Tree>(max_word_size, t1_permutation, words_per_length_in_text, words_in_the_text, words_per_length_not_in_text, words_not_in_the_text);
   }
   single_text_manager->compute_averages(permutations, 1);
   single_text_manager->print(1);
@@ -417,6 +657,7 @@ template <class structure> double similarity_experiment(std::vector<std::string>
   for(int i = 0; i < t2_perm.size(); i++){
     T->insert(t2_perm[i], i, 1);
   }
+  finish_insertions(T);
   auto end = std::chrono::steady_clock::now();
   double elapsed_time = elapsed_time_milli(start, end);
   data.push_back(elapsed_time_seconds(elapsed_time));
@@ -437,9 +678,14 @@ template <class structure> double similarity_experiment(std::vector<std::string>
   data.push_back(data[0] + data[2]); //Total time
   data.push_back(text_similarity);
 
-  similarity_manager->update_values(T->get_name(), data);
+  std::string name = T->get_name();
+  print_statistics(T, similarity_manager);
+  start = std::chrono::steady_clock::now();
   T->delete_data();
   delete T;
+  end = std::chrono::steady_clock::now();
+  data.push_back(elapsed_time_milli(start, end)); //Teardown time
+  similarity_manager->update_values(name, data);
   return text_similarity;
 }
 
@@ -462,7 +708,7 @@ double similarity_experiments(std::vector<std::string> t1, std::vector<std::stri
   auto last = std::unique(dictionary.begin(), dictionary.end());
   dictionary.erase(last, dictionary.end());
 
-  std::vector<double> similarity(3, 0.0);
+  std::vector<double> similarity(6, 0.0);
   for (int permutation = 0; permutation < permutations; permutation++){
     //We permutate the input words to the structure and perform the experiment permutations number of times.
     std::shuffle(t1_permutation.begin(), t1_permutation.end(), generator);
@@ -472,11 +718,17 @@ double similarity_experiments(std::vector<std::string> t1, std::vector<std::stri
     double pat = similarity_experiment<Patricia_Tree>(t1_permutation, t2_permutation, dictionary);
     double ter = similarity_experiment<Ternary_Search_Tree>(t1_permutation, t2_permutation, dictionary);
     double has = similarity_experiment<Hash_Table>(t1_permutation, t2_permutation, dictionary);
+    double crit = similarity_experiment<Crit_Bit_Tree>(t1_permutation, t2_permutation, dictionary);
+    double art = similarity_experiment<Adaptive_Radix_Tree>(t1_permutation, t2_permutation, dictionary);
+    double hat = similarity_experiment<Hat_Trie>(t1_permutation, t2_permutation, dictionary);
 
     similarity[0] = similarity[0] + pat;
     similarity[1] = similarity[1] + ter;
     similarity[2] = similarity[2] + has;
-    std::cout << pat << " Patricia| " << ter << " Ternary| " << has << " Hash|" << std::endl;
+    similarity[3] = similarity[3] + crit;
+    similarity[4] = similarity[4] + art;
+    similarity[5] = similarity[5] + hat;
+    std::cout << pat << " Patricia| " << ter << " Ternary| " << has << " Hash| " << crit << " Crit-bit| " << art << " ART| " << hat << " HAT|" << std::endl;
 
     // similarity[0] = similarity[0] + similarity_experiment<Patricia_Tree>(t1_permutation, t2_permutation, t1t2);
     // similarity[1] = similarity[1] + similarity_experiment<Ternary_Search_Tree>(t1_permutation, t2_permutation, t1t2);
@@ -526,8 +778,374 @@ void perform_similarity_experiments(std::vector<std::string> book_names, std::st
   delete similarity_manager;
 }
 
+//Inserts the words into a Hash_Table, resizing with stop-the-world doubling or incrementally, and
+//measures the time taken by each insertion on its own, in milliseconds.
+std::vector<double> insert_latencies(std::vector<std::string> words, bool incremental_resize){
+  std::vector<double> latencies(words.size(), 0.0);
+  Hash_Table *T = new Hash_Table(incremental_resize);
+  for(int i = 0; i < words.size(); i++){
+    auto start = std::chrono::steady_clock::now();
+    T->insert(words[i], i, 0);
+    auto end = std::chrono::steady_clock::now();
+    latencies[i] = elapsed_time_milli(start, end);
+  }
+  T->delete_data();
+  delete T;
+  return latencies;
+}
+
+//Compares the latency of single insertions for both resizing modes of the Hash_Table. For every
+//size 2^i and alphabet size a random sample of words is inserted, and the total, average, 99th percentile
+//and maximum insertion times are averaged over the repetitions and written to insert_latency_experiments.csv.
+void insert_latency_experiments(double average_word_length, std::vector<int> alphabet_sizes, int starting_size, int final_size, int repetitions){
+  std::ofstream output("insert_latency_experiments.csv");
+  output << "Alg, i, |sigma|, insert_time(s), avg_insert(ms), p99_insert(ms), max_insert(ms)" << std::endl;
+  std::vector<std::string> names = {"HASH", "HASH_INC"};
+  for(int i = starting_size; i <= final_size; i++){
+    std::cout << "Size: " << i << std::endl;
+    for(int alphabet = 0; alphabet < alphabet_sizes.size(); alphabet++){
+      int starting_character = 97;
+      if(alphabet_sizes[alphabet] > 26){
+        starting_character = 33;
+      }
+      std::vector<std::vector<double>> data(2, std::vector<double>(4, 0.0));
+      for(int repetition = 0; repetition < repetitions; repetition++){
+        std::vector<std::string> words = random_words(pick_word_lengths(average_word_length, pow(2,i)), alphabet_sizes[alphabet], starting_character);
+        std::shuffle(words.begin(), words.end(), generator);
+        for(int mode = 0; mode < 2; mode++){
+          std::vector<double> latencies = insert_latencies(words, mode);
+          double total = 0.0;
+          for(int j = 0; j < latencies.size(); j++){
+            total = total + latencies[j];
+          }
+          std::sort(latencies.begin(), latencies.end());
+          data[mode][0] = data[mode][0] + elapsed_time_seconds(total);
+          data[mode][1] = data[mode][1] + total/latencies.size();
+          data[mode][2] = data[mode][2] + latencies[(std::size_t)(0.99*(latencies.size()-1))];
+          data[mode][3] = data[mode][3] + latencies[latencies.size()-1];
+        }
+      }
+      for(int mode = 0; mode < 2; mode++){
+        std::string text = names[mode] + ", " + std::to_string(i) + ", " + std::to_string(alphabet_sizes[alphabet]);
+        for(int j = 0; j < 4; j++){
+          text = text + ", " + std::to_string(data[mode][j]/repetitions);
+        }
+        output << text << std::endl;
+      }
+    }
+  }
+  output.close();
+}
+
+//Splits the patterns in consecutive batches of batch_size patterns (the last one can be shorter), searches
+//every batch with search_batch and returns the time taken, in milliseconds. The number of patterns
+//that were found is added to found. The batches are built before the clock starts.
+double batch_search_time(Hash_Table *T, std::vector<std::string> patterns, std::size_t batch_size, std::size_t *found){
+  std::vector<std::vector<std::string>> batches;
+  for(std::size_t i = 0; i < patterns.size(); i = i + batch_size){
+    batches.push_back(std::vector<std::string>(patterns.begin() + i, patterns.begin() + std::min(i + batch_size, patterns.size())));
+  }
+  std::vector<bool> out;
+  auto start = std::chrono::steady_clock::now();
+  for(std::size_t batch = 0; batch < batches.size(); batch++){
+    T->search_batch(batches[batch], out);
+    for(std::size_t i = 0; i < out.size(); i++){
+      *found = *found + out[i];
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+  return elapsed_time_milli(start, end);
+}
+
+//Measures the lookup throughput of the Hash_Table against the size of the batches given to search_batch.
+//For every size 2^i and alphabet size a random sample of words is inserted, then the words (in a different
+//order) and a sample of words that were not inserted are searched in batches of each of the batch_sizes.
+//A batch size of 1 resolves the searches one at a time, like the other experiments do. The times and
+//searches per second are averaged over the repetitions and written to batch_search_experiments.csv.
+void batch_search_experiments(double average_word_length, std::vector<int> alphabet_sizes, int starting_size, int final_size, int repetitions, std::vector<std::size_t> batch_sizes){
+  std::ofstream output("batch_search_experiments.csv");
+  output << "Alg, i, |sigma|, batch_size, search_time(s), searches_per_second, miss_time(s), misses_per_second" << std::endl;
+  for(int i = starting_size; i <= final_size; i++){
+    std::cout << "Size: " << i << std::endl;
+    for(int alphabet = 0; alphabet < alphabet_sizes.size(); alphabet++){
+      int starting_character = 97;
+      if(alphabet_sizes[alphabet] > 26){
+        starting_character = 33;
+      }
+      std::vector<std::vector<double>> data(batch_sizes.size(), std::vector<double>(4, 0.0));
+      for(int repetition = 0; repetition < repetitions; repetition++){
+        std::vector<std::string> words = random_words(pick_word_lengths(average_word_length, pow(2,i)), alphabet_sizes[alphabet], starting_character);
+        std::vector<std::string> missing_words = words_not_in_text(words.size(), alphabet_sizes[alphabet], starting_character, words, average_word_length*2);
+        std::shuffle(words.begin(), words.end(), generator);
+        Hash_Table *T = new Hash_Table();
+        for(int j = 0; j < words.size(); j++){
+          T->insert(words[j], j, 0);
+        }
+        std::shuffle(words.begin(), words.end(), generator);
+        for(int batch = 0; batch < batch_sizes.size(); batch++){
+          std::size_t found = 0;
+          double search_time = batch_search_time(T, words, batch_sizes[batch], &found);
+          std::size_t found_missing = 0;
+          double miss_time = batch_search_time(T, missing_words, batch_sizes[batch], &found_missing);
+          if(found != words.size()){
+            std::cout << "SOME KEYS THAT SHOULD  HAVE BEEN FOUND WERE NOT FOUND!!! batch size: " << batch_sizes[batch] << std::endl;
+          }
+          if(found_missing > 0){
+            std::cout << "SOME KEYS THAT SHOULDN'T HAVE BEEN FOUND WERE FOUND!!! batch size: " << batch_sizes[batch] << std::endl;
+          }
+          data[batch][0] = data[batch][0] + elapsed_time_seconds(search_time);
+          data[batch][1] = data[batch][1] + words.size()/elapsed_time_seconds(search_time);
+          data[batch][2] = data[batch][2] + elapsed_time_seconds(miss_time);
+          data[batch][3] = data[batch][3] + missing_words.size()/elapsed_time_seconds(miss_time);
+        }
+        T->delete_data();
+        delete T;
+      }
+      for(int batch = 0; batch < batch_sizes.size(); batch++){
+        std::string text = "HASH, " + std::to_string(i) + ", " + std::to_string(alphabet_sizes[alphabet]) + ", " + std::to_string(batch_sizes[batch]);
+        for(int j = 0; j < 4; j++){
+          text = text + ", " + std::to_string(data[batch][j]/repetitions);
+        }
+        output << text << std::endl;
+      }
+    }
+  }
+  output.close();
+}
+
+//Measures the quality of a hash function for a workload: the cost of hashing each of the words (in nanoseconds),
+//the average and maximum number of slots probed to find a key of the table built with the words, and the
+//searches per second when every one of the queries is searched. The results are written as a row of output.
+template <class hasher> void hash_quality(std::vector<std::string> words, std::vector<std::string> queries, std::string workload, std::ofstream &output){
+  hasher hash_function;
+  volatile std::size_t sink = 0; //keeps the hashes from being optimized away.
+  auto start = std::chrono::steady_clock::now();
+  for(int i = 0; i < words.size(); i++){
+    sink = sink ^ hash_function(words[i]);
+  }
+  auto end = std::chrono::steady_clock::now();
+  double hash_time = elapsed_time_milli(start, end)*1000000/words.size();
+
+  Basic_Hash_Table<hasher> *T = new Basic_Hash_Table<hasher>();
+  for(int i = 0; i < words.size(); i++){
+    T->insert(words[i], i, 0);
+  }
+  std::vector<double> probe_lengths = T->probe_length_statistics();
+  bool are_all_keys_found = 1;
+  start = std::chrono::steady_clock::now();
+  for(int i = 0; i < queries.size(); i++){
+    are_all_keys_found = are_all_keys_found && T->search_report(queries[i], 0, 0);
+  }
+  end = std::chrono::steady_clock::now();
+  if(!are_all_keys_found){
+    std::cout << "SOME KEYS THAT SHOULD  HAVE BEEN FOUND WERE NOT FOUND!!! " << T->get_name() << std::endl;
+  }
+  double searches_per_second = queries.size()/elapsed_time_seconds(elapsed_time_milli(start, end));
+  output << T->get_name() << ", " << workload << ", " << words.size() << ", " << hash_time << ", " << probe_lengths[0] << ", " << probe_lengths[1] << ", " << searches_per_second << std::endl;
+  T->delete_data();
+  delete T;
+}
+
+//Runs hash_quality for every hash function on the same workload.
+void hash_quality_all(std::vector<std::string> words, std::vector<std::string> queries, std::string workload, std::ofstream &output){
+  hash_quality<Std_Hash>(words, queries, workload, output);
+  hash_quality<Wy_Hash>(words, queries, workload, output);
+  hash_quality<Fnv_Hash>(words, queries, workload, output);
+  hash_quality<Crc_Hash>(words, queries, workload, output);
+}
+
+//Compares the hash functions of the Hash_Table on random words of every alphabet size (2^final_size words,
+//searched in a different order than they were inserted) and on the complete books (searching a random
+//sample of their words), writing the results to hash_quality_experiments.csv.
+void hash_quality_experiments(double average_word_length, std::vector<int> alphabet_sizes, int final_size, std::vector<std::string> book_names, std::string folder, std::string extension){
+  std::ofstream output("hash_quality_experiments.csv");
+  output << "Alg, workload, words, hash_time(ns), avg_probe, max_probe, searches_per_second" << std::endl;
+  for(int alphabet = 0; alphabet < alphabet_sizes.size(); alphabet++){
+    std::cout << "|sigma|: " << alphabet_sizes[alphabet] << std::endl;
+    int starting_character = 97;
+    if(alphabet_sizes[alphabet] > 26){
+      starting_character = 33;
+    }
+    std::vector<std::string> words = random_words(pick_word_lengths(average_word_length, pow(2,final_size)), alphabet_sizes[alphabet], starting_character);
+    std::shuffle(words.begin(), words.end(), generator);
+    std::vector<std::string> queries = words;
+    std::shuffle(queries.begin(), queries.end(), generator);
+    hash_quality_all(words, queries, "sigma_" + std::to_string(alphabet_sizes[alphabet]), output);
+  }
+  for(int i = 0; i < book_names.size(); i++){
+    std::cout << "Book: " << book_names[i] << std::endl;
+    std::vector<std::string> words = words_from_text_with_space(folder + book_names[i] + extension);
+    if(words.empty()){
+      std::cout << "  " << folder + book_names[i] + extension << " has no words, skipping it" << std::endl;
+      continue;
+    }
+    std::vector<std::string> queries = random_words_in_text(words.size(), words);
+    std::shuffle(queries.begin(), queries.end(), generator);
+    hash_quality_all(words, queries, book_names[i], output);
+  }
+  output.close();
+}
+
+//Inserts the words in a structure and searches for every query on its own, returns the load factor of the
+//structure, the average and maximum number of slots inspected to find a stored key, and the average and
+//maximum time taken by a single search, in milliseconds.
+template <class structure> std::vector<double> lookup_cost(std::vector<std::string> words, std::vector<std::string> queries){
+  structure *T = new structure();
+  for(int i = 0; i < words.size(); i++){
+    T->insert(words[i], i, 0);
+  }
+  std::vector<double> data = {T->get_fill()};
+  std::vector<double> probe_lengths = T->probe_length_statistics();
+  data.insert(data.end(), probe_lengths.begin(), probe_lengths.end());
+  double total = 0.0;
+  double max = 0.0;
+  bool are_all_keys_found = 1;
+  for(int i = 0; i < queries.size(); i++){
+    auto start = std::chrono::steady_clock::now();
+    are_all_keys_found = are_all_keys_found && T->search_report(queries[i], 0, 0);
+    auto end = std::chrono::steady_clock::now();
+    total = total + elapsed_time_milli(start, end);
+    max = std::max(max, elapsed_time_milli(start, end));
+  }
+  if(!are_all_keys_found){
+    std::cout << "SOME KEYS THAT SHOULD  HAVE BEEN FOUND WERE NOT FOUND!!! " << T->get_name() << std::endl;
+  }
+  data.push_back(total/queries.size());
+  data.push_back(max);
+  T->delete_data();
+  delete T;
+  return data;
+}
+
+//Compares the cost of the searches of the Hash_Table (linear probing) and the Cuckoo_Table, whose searches
+//inspect at most 2 buckets. For every size 2^i and alphabet size a random sample of words is inserted and
+//searched again in a different order, the results are averaged over the repetitions (the maximums are the
+//maximums over all of them) and written to lookup_cost_experiments.csv.
+void lookup_cost_experiments(double average_word_length, std::vector<int> alphabet_sizes, int starting_size, int final_size, int repetitions){
+  std::ofstream output("lookup_cost_experiments.csv");
+  output << "Alg, i, |sigma|, fill, avg_probe, max_probe, avg_search(ms), max_search(ms)" << std::endl;
+  std::vector<std::string> names = {"HASH", "CUCKOO"};
+  for(int i = starting_size; i <= final_size; i++){
+    std::cout << "Size: " << i << std::endl;
+    for(int alphabet = 0; alphabet < alphabet_sizes.size(); alphabet++){
+      int starting_character = 97;
+      if(alphabet_sizes[alphabet] > 26){
+        starting_character = 33;
+      }
+      std::vector<std::vector<double>> data(2, std::vector<double>(5, 0.0));
+      for(int repetition = 0; repetition < repetitions; repetition++){
+        std::vector<std::string> words = random_words(pick_word_lengths(average_word_length, pow(2,i)), alphabet_sizes[alphabet], starting_character);
+        std::shuffle(words.begin(), words.end(), generator);
+        std::vector<std::string> queries = words;
+        std::shuffle(queries.begin(), queries.end(), generator);
+        std::vector<std::vector<double>> costs = {lookup_cost<Hash_Table>(words, queries), lookup_cost<Cuckoo_Table>(words, queries)};
+        for(int table = 0; table < 2; table++){
+          data[table][0] = data[table][0] + costs[table][0];
+          data[table][1] = data[table][1] + costs[table][1];
+          data[table][2] = std::max(data[table][2], costs[table][2]);
+          data[table][3] = data[table][3] + costs[table][3];
+          data[table][4] = std::max(data[table][4], costs[table][4]);
+        }
+      }
+      for(int table = 0; table < 2; table++){
+        output << names[table] << ", " << i << ", " << alphabet_sizes[alphabet] << ", " << data[table][0]/repetitions << ", " << data[table][1]/repetitions;
+        output << ", " << data[table][2] << ", " << data[table][3]/repetitions << ", " << data[table][4] << std::endl;
+      }
+    }
+  }
+  output.close();
+}
+
+//Builds a Ternary_Search_Tree with the keys (sorted and different) and their values, inserting them one by one in
+//order if bulk is 0, or with bulk_load otherwise. Then searches every key in a different order. Returns the build
+//time, the depth of the tree, the search time (all of them in milliseconds but the depth) and the size of the tree.
+std::vector<double> tst_build(Ternary_Search_Tree *T, std::vector<std::string> &keys, std::vector<std::vector<std::vector<std::size_t>>> &key_values, std::vector<std::string> &queries, bool bulk){
+  auto start = std::chrono::steady_clock::now();
+  if(bulk){
+    T->bulk_load(keys, key_values);
+  }else{
+    for(std::size_t i = 0; i < keys.size(); i++){
+      T->insert(keys[i], key_values[i][0][0], 0);
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+  std::vector<double> data = {elapsed_time_milli(start, end), T->extra_measurement()};
+  bool are_all_keys_found = 1;
+  start = std::chrono::steady_clock::now();
+  for(std::size_t i = 0; i < queries.size(); i++){
+    are_all_keys_found = are_all_keys_found && T->search_report(queries[i], 0, 0);
+  }
+  end = std::chrono::steady_clock::now();
+  if(!are_all_keys_found){
+    std::cout << "SOME KEYS THAT SHOULD  HAVE BEEN FOUND WERE NOT FOUND!!! " << T->get_name() << std::endl;
+  }
+  data.push_back(elapsed_time_milli(start, end));
+  data.push_back(T->structure_size());
+  T->delete_data();
+  return data;
+}
+
+//Compares three ways of building a Ternary_Search_Tree from sorted keys, the worst insertion order for a plain
+//tree: inserting them in order in a plain tree (TERN), in a balanced one (TERN_TREAP), and loading them all at
+//once with bulk_load (TERN_BULK). For every size 2^i and alphabet size a random sample of words is made unique and
+//sorted, and the build time, depth, search time and size are averaged over the repetitions and written to
+//tst_build_experiments.csv.
+void tst_build_experiments(double average_word_length, std::vector<int> alphabet_sizes, int starting_size, int final_size, int repetitions){
+  std::ofstream output("tst_build_experiments.csv");
+  output << "Alg, i, |sigma|, keys, build_time(ms), depth, search_time(ms), size(bytes)" << std::endl;
+  std::vector<std::string> names = {"TERN", "TERN_TREAP", "TERN_BULK"};
+  for(int i = starting_size; i <= final_size; i++){
+    std::cout << "Size: " << i << std::endl;
+    for(int alphabet = 0; alphabet < alphabet_sizes.size(); alphabet++){
+      int starting_character = 97;
+      if(alphabet_sizes[alphabet] > 26){
+        starting_character = 33;
+      }
+      std::vector<std::vector<double>> data(3, std::vector<double>(4, 0.0));
+      std::size_t keys_count = 0;
+      for(int repetition = 0; repetition < repetitions; repetition++){
+        std::vector<std::string> keys = random_words(pick_word_lengths(average_word_length, pow(2,i)), alphabet_sizes[alphabet], starting_character);
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+        keys_count = keys_count + keys.size();
+        std::vector<std::vector<std::vector<std::size_t>>> key_values(keys.size());
+        for(std::size_t key = 0; key < keys.size(); key++){
+          key_values[key] = {{key}, {}};
+        }
+        std::vector<std::string> queries = keys;
+        std::shuffle(queries.begin(), queries.end(), generator);
+        Ternary_Search_Tree *plain = new Ternary_Search_Tree();
+        Ternary_Search_Tree *balanced = new Ternary_Search_Tree(1);
+        std::vector<std::vector<double>> results = {tst_build(plain, keys, key_values, queries, 0), tst_build(balanced, keys, key_values, queries, 0), tst_build(plain, keys, key_values, queries, 1)};
+        delete plain;
+        delete balanced;
+        for(int tree = 0; tree < 3; tree++){
+          for(int j = 0; j < 4; j++){
+            data[tree][j] = data[tree][j] + results[tree][j];
+          }
+        }
+      }
+      for(int tree = 0; tree < 3; tree++){
+        output << names[tree] << ", " << i << ", " << alphabet_sizes[alphabet] << ", " << keys_count/repetitions;
+        for(int j = 0; j < 4; j++){
+          output << ", " << data[tree][j]/repetitions;
+        }
+        output << std::endl;
+      }
+    }
+  }
+  output.close();
+}
+
 int main(){
-  int experiment_type = 0; // Pick 0 for random experiments, 1 for single text testing and 2 for similarity testing.
+#ifdef PATRICIA_ALLOCATION_CHECK
+  //Fails before any experiment runs if searching the Patricia_Tree allocates memory.
+  example_5_patricia();
+#endif
+  int experiment_type = 0; // Pick 0 for random experiments, 1 for single text testing, 2 for similarity testing,
+  //3 for the insertion latency of the Hash_Table resizing modes, 4 for the batched searches of the Hash_Table,
+  //5 to compare the hash functions of the Hash_Table, 6 to compare the search costs of linear probing and cuckoo hashing
+  //and 7 to compare the ways of building a Ternary_Search_Tree from sorted keys.
 
   if(experiment_type == 0){
     //These experiments construct a sample of 2^i random words, where letters are picked with a uniform distribution,
@@ -570,6 +1188,40 @@ int main(){
     std::vector<std::string> book_names = {"book_1", "book_2", "book_3", "book_4", "book_5", "bible", "book_1_malazan", "book_2_malazan", "book_3_malazan", "book_4_malazan", "book_5_malazan", "book_6_malazan", "book_7_malazan", "book_8_malazan", "book_9_malazan", "book_10_malazan"};
     //the last parameter corresponds to the number of permutations that will be used for each (size, book, book) triple.
     perform_similarity_experiments(book_names, folder, extension, 3);
+  }else if(experiment_type == 3){
+    //Inserts random words, just like the random experiments, into a Hash_Table that doubles in a single insertion
+    //and one that resizes incrementally, to compare the worst insertion times of both.
+    //Parameters are average_word_length, alphabet_sizes, starting value of i, terminal value of i and repetitions.
+    std::vector<int> alphabet_sizes = {2,26,94};
+    insert_latency_experiments(5.2, alphabet_sizes, 10, 22, 3);
+  }else if(experiment_type == 4){
+    //Searches random words in a Hash_Table in batches of different sizes, to plot the lookup throughput against
+    //the batch size. Parameters are average_word_length, alphabet_sizes, starting value of i, terminal value of i,
+    //repetitions and the batch sizes.
+    std::vector<int> alphabet_sizes = {2,26,94};
+    std::vector<std::size_t> batch_sizes = {1,2,4,8,16,32,64,128};
+    batch_search_experiments(5.2, alphabet_sizes, 10, 22, 3, batch_sizes);
+  }else if(experiment_type == 5){
+    //Compares the cost, the probe lengths and the search throughput of the hash functions of the Hash_Table
+    //on random words of several alphabet sizes and on the 16 books. Parameters are average_word_length,
+    //alphabet_sizes, the value of i for the random words, and the books.
+    std::vector<int> alphabet_sizes = {2,4,6,8,10,20,26,40,60,80,94};
+    std::string folder = "./text/single_books/";
+    std::string extension = ".txt";
+    std::vector<std::string> book_names = {"book_1", "book_2", "book_3", "book_4", "book_5", "bible", "book_1_malazan", "book_2_malazan", "book_3_malazan", "book_4_malazan", "book_5_malazan", "book_6_malazan", "book_7_malazan", "book_8_malazan", "book_9_malazan", "book_10_malazan"};
+    hash_quality_experiments(5.2, alphabet_sizes, 20, book_names, folder, extension);
+  }else if(experiment_type == 6){
+    //Compares the average and maximum number of slots inspected, and the average and maximum time of a single
+    //search, of the Hash_Table and the Cuckoo_Table. Parameters are average_word_length, alphabet_sizes,
+    //starting value of i, terminal value of i and repetitions.
+    std::vector<int> alphabet_sizes = {2,4,6,8,10,20,26,40,60,80,94};
+    lookup_cost_experiments(5.2, alphabet_sizes, 10, 20, 3);
+  }else if(experiment_type == 7){
+    //Builds Ternary_Search_Trees from sorted random words, inserting them in a plain tree and in a balanced one,
+    //and with bulk_load. Parameters are average_word_length, alphabet_sizes, starting value of i, terminal value
+    //of i and repetitions.
+    std::vector<int> alphabet_sizes = {2,26,94};
+    tst_build_experiments(5.2, alphabet_sizes, 10, 20, 3);
   }else{
     //Further experiments can be performed here.
   }
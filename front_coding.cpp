@@ -0,0 +1,276 @@
+#include "front_coding.hpp"
+
+//Appends a length as a varint: 7 bits per byte, from the lowest ones, with the highest bit set in every byte but the last.
+void write_varint(std::vector<char> &bytes, std::size_t value){
+  while(value >= 128){
+    bytes.push_back((char)((value & 127) | 128));
+    value = value >> 7;
+  }
+  bytes.push_back((char)value);
+}
+
+//Reads a varint and moves bytes past it.
+std::size_t read_varint(const char **bytes){
+  std::size_t value = 0;
+  int shift = 0;
+  while((unsigned char)**bytes >= 128){
+    value = value | ((std::size_t)((unsigned char)**bytes & 127) << shift);
+    shift = shift + 7;
+    (*bytes)++;
+  }
+  value = value | ((std::size_t)(unsigned char)**bytes << shift);
+  (*bytes)++;
+  return value;
+}
+
+//Front_Coded_Dictionary constructor. The dictionary starts empty, the insertions are kept in the loading table
+//until freeze is called (or the dictionary is built directly from the keys and values of any dictionary with build).
+template <std::size_t bucket_size>
+Basic_Front_Coded_Dictionary<bucket_size>::Basic_Front_Coded_Dictionary(){
+  this->keys = 0;
+  this->name = "FC" + std::to_string(bucket_size);
+  this->build_time = 0.0;
+}
+
+//Insertions are only possible before the dictionary is frozen.
+template <std::size_t bucket_size>
+void Basic_Front_Coded_Dictionary<bucket_size>::insert(const std::string &pattern, std::size_t value, int text_index){
+  if(!this->loading_table.insert(pattern, value, text_index)){
+    std::cout << "THE DICTIONARY IS FROZEN, " << pattern << " WAS NOT INSERTED!!!" << std::endl;
+  }
+}
+
+//Builds the dictionary with the keys inserted so far.
+template <std::size_t bucket_size>
+void Basic_Front_Coded_Dictionary<bucket_size>::freeze(){
+  std::vector<std::string> keys;
+  std::vector<std::vector<std::vector<std::size_t>>> key_values;
+  if(this->loading_table.take_contents(keys, key_values)){
+    this->build(keys, key_values);
+  }
+}
+
+//Compiles the dictionary from the keys of a dictionary (which must be different) and their values for each text.
+//The keys are sorted lexicographically rather than with string_compare: grouping them by length first would
+//separate keys that share long prefixes, which is what front coding saves. The time taken is kept in build_time,
+//in milliseconds.
+template <std::size_t bucket_size>
+void Basic_Front_Coded_Dictionary<bucket_size>::build(std::vector<std::string> &keys, std::vector<std::vector<std::vector<std::size_t>>> &key_values){
+  auto start_time = std::chrono::steady_clock::now();
+  this->loading_table.release();
+  this->keys = keys.size();
+  std::vector<std::size_t> order(this->keys);
+  for(std::size_t i = 0; i < this->keys; i++){
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(), [&keys](std::size_t a, std::size_t b){
+    return keys[a] < keys[b];
+  });
+
+  this->buckets.clear();
+  this->bucket_offsets.clear();
+  this->postings.start(this->keys);
+  for(std::size_t i = 0; i < this->keys; i++){
+    const std::string &key = keys[order[i]];
+    if(i%bucket_size == 0){
+      this->bucket_offsets.push_back(this->buckets.size());
+      write_varint(this->buckets, key.size());
+      this->buckets.insert(this->buckets.end(), key.begin(), key.end());
+    }else{
+      const std::string &previous = keys[order[i - 1]];
+      std::size_t lcp = 0;
+      while(lcp < key.size() && lcp < previous.size() && key[lcp] == previous[lcp]){
+        lcp++;
+      }
+      write_varint(this->buckets, lcp);
+      write_varint(this->buckets, key.size() - lcp);
+      this->buckets.insert(this->buckets.end(), key.begin() + lcp, key.end());
+    }
+    this->postings.add_key(key_values[order[i]]);
+  }
+  this->buckets.shrink_to_fit();
+  this->bucket_offsets.shrink_to_fit();
+  this->postings.shrink_to_fit();
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start_time;
+  this->build_time = elapsed.count();
+}
+
+//Deletes the loading table, if the dictionary was never frozen, and releases the arrays.
+template <std::size_t bucket_size>
+void Basic_Front_Coded_Dictionary<bucket_size>::delete_data(){
+  this->loading_table.release();
+  std::vector<char>().swap(this->buckets);
+  std::vector<std::uint32_t>().swap(this->bucket_offsets);
+  this->postings.clear();
+  this->keys = 0;
+}
+
+//Compares the header of a bucket with the pattern, returns a negative number if the header comes first, 0 if they
+//are equal and a positive number if the pattern comes first.
+template <std::size_t bucket_size>
+int Basic_Front_Coded_Dictionary<bucket_size>::compare_header(std::size_t bucket, const std::string &pattern){
+  const char *header = this->buckets.data() + this->bucket_offsets[bucket];
+  std::size_t length = read_varint(&header);
+  int comparison = std::memcmp(header, pattern.data(), std::min(length, pattern.size()));
+  if(comparison != 0){
+    return comparison;
+  }
+  return (length > pattern.size()) - (length < pattern.size());
+}
+
+//Returns the id of the pattern, or no_key if it is not in the dictionary. The bucket is the last one whose header
+//does not come after the pattern. The bucket is scanned without rebuilding its keys: matched is the length of the
+//prefix that the current key shares with the pattern, and since the keys are sorted a key that shares less than
+//matched characters with the previous one comes after the pattern, and one that shares more comes before it.
+//Only the keys that share exactly matched characters are compared, from there on.
+template <std::size_t bucket_size>
+std::uint32_t Basic_Front_Coded_Dictionary<bucket_size>::locate(const std::string &pattern){
+  std::size_t low = 0;
+  std::size_t high = this->bucket_offsets.size();
+  while(low < high){
+    std::size_t middle = (low + high)/2;
+    if(this->compare_header(middle, pattern) <= 0){
+      low = middle + 1;
+    }else{
+      high = middle;
+    }
+  }
+  if(low == 0){
+    return no_key;
+  }
+  std::size_t bucket = low - 1;
+  const char *bytes = this->buckets.data() + this->bucket_offsets[bucket];
+  std::size_t length = read_varint(&bytes);
+  std::size_t matched = 0;
+  while(matched < length && matched < pattern.size() && bytes[matched] == pattern[matched]){
+    matched++;
+  }
+  if(matched == length && matched == pattern.size()){
+    return bucket*bucket_size;
+  }
+  bytes = bytes + length;
+  std::size_t last = std::min(this->keys, (bucket + 1)*bucket_size);
+  for(std::size_t id = bucket*bucket_size + 1; id < last; id++){
+    std::size_t lcp = read_varint(&bytes);
+    std::size_t suffix_length = read_varint(&bytes);
+    if(lcp < matched){
+      return no_key;
+    }
+    if(lcp == matched){
+      std::size_t common = 0;
+      while(common < suffix_length && matched + common < pattern.size() && bytes[common] == pattern[matched + common]){
+        common++;
+      }
+      matched = matched + common;
+      if(common == suffix_length && matched == pattern.size()){
+        return id;
+      }
+      if(common < suffix_length && (matched == pattern.size() || (unsigned char)bytes[common] > (unsigned char)pattern[matched])){
+        return no_key;
+      }
+    }
+    bytes = bytes + suffix_length;
+  }
+  return no_key;
+}
+
+//Returns the key with a given id, rebuilding the keys of its bucket up to it.
+template <std::size_t bucket_size>
+std::string Basic_Front_Coded_Dictionary<bucket_size>::extract(std::uint32_t id){
+  if(id >= this->keys){
+    return "VALUE NOT FOUND";
+  }
+  const char *bytes = this->buckets.data() + this->bucket_offsets[id/bucket_size];
+  std::size_t length = read_varint(&bytes);
+  std::string key(bytes, length);
+  bytes = bytes + length;
+  for(std::size_t i = 0; i < id%bucket_size; i++){
+    std::size_t lcp = read_varint(&bytes);
+    std::size_t suffix_length = read_varint(&bytes);
+    key.resize(lcp);
+    key.append(bytes, suffix_length);
+    bytes = bytes + suffix_length;
+  }
+  return key;
+}
+
+//Returns the average number of bytes that a key takes in the buckets.
+template <std::size_t bucket_size>
+double Basic_Front_Coded_Dictionary<bucket_size>::bytes_per_key(){
+  if(this->keys == 0){
+    return 0.0;
+  }
+  return (double)this->buckets.size()/this->keys;
+}
+
+//Reports whether the pattern is in the dictionary.
+//If print is enabled prints information pertaining to the values associated
+//to the pattern in the given text.
+template <std::size_t bucket_size>
+bool Basic_Front_Coded_Dictionary<bucket_size>::search_report(const std::string &pattern, int text_index, int print){
+  std::uint32_t id = this->locate(pattern);
+  if(id == no_key){
+    return 0;
+  }
+  if(print){
+    std::cout << pattern << " found with id " << id << " and " << this->postings.count(id, text_index) << " occurences at positions: ";
+    this->postings.print(id, text_index);
+    std::cout << std::endl;
+  }
+  return 1;
+}
+
+//Returns the size of the structure, in bytes. Includes the loading table if it was never frozen.
+template <std::size_t bucket_size>
+std::size_t Basic_Front_Coded_Dictionary<bucket_size>::structure_size(){
+  std::size_t size = sizeof(Basic_Front_Coded_Dictionary<bucket_size>) + this->name.capacity()*sizeof(char);
+  size = size + this->buckets.capacity()*sizeof(char) + this->bucket_offsets.capacity()*sizeof(std::uint32_t);
+  size = size + this->postings.structure_size();
+  return size + this->loading_table.structure_size();
+}
+
+//Returns all occurences of the pattern, for each text.
+template <std::size_t bucket_size>
+std::vector<std::size_t> Basic_Front_Coded_Dictionary<bucket_size>::occurences(const std::string &pattern){
+  std::uint32_t id = this->locate(pattern);
+  if(id == no_key){
+    return std::vector<std::size_t> {0, 0};
+  }
+  return this->postings.counts(id);
+}
+
+//The dictionaries are only built with the bucket sizes of the typedefs in front_coding.hpp.
+template class Basic_Front_Coded_Dictionary<4>;
+template class Basic_Front_Coded_Dictionary<16>;
+template class Basic_Front_Coded_Dictionary<64>;
+
+//Simple example of usage, with buckets of 4 keys, locating the keys and extracting them back from their ids.
+void example_1_front_coding(){
+  Front_Coded_Dictionary_4 *Dictionary = new Front_Coded_Dictionary_4();
+  Dictionary->insert("hola", 0, 0);
+  Dictionary->insert("ola", 1, 0);
+  Dictionary->insert("holograma", 2, 0);
+  Dictionary->insert("holografia", 3, 0);
+  Dictionary->insert("ho", 4, 0);
+  Dictionary->insert("h", 5, 0);
+  Dictionary->insert("hola", 50, 0);
+  Dictionary->freeze();
+
+  Dictionary->search_report("hola", 0, 1);
+  Dictionary->search_report("holograma", 0, 1);
+  Dictionary->search_report("ola", 0, 1);
+  Dictionary->search_report("ho", 0, 1);
+  Dictionary->search_report("hol", 0, 1);
+  for(std::uint32_t id = 0; id < 6; id++){
+    std::cout << id << ": " << Dictionary->extract(id) << std::endl;
+  }
+
+  Dictionary->delete_data();
+  delete Dictionary;
+}
+
+//UNCOMMENT MAIN TO TEST EXAMPLES IN STANDALONE FASHION
+// int main(){
+//   example_1_front_coding();
+//   return 0;
+// }
@@ -0,0 +1,61 @@
+#ifndef __FC_H_INCLUDED__
+#define __FC_H_INCLUDED__
+
+#include <string>
+#include <iostream>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <chrono>
+#include "frozen_dictionary.hpp"
+
+//A Front_Coded_Dictionary is an immutable sorted array of the keys of a finished dictionary, compressed with front
+//coding. The keys are sorted lexicographically, numbered in that order (their id) and split in buckets of bucket_size
+//keys. A bucket starts with its first key (the header) in full, and every following key is stored as the length of
+//the prefix it shares with the previous one (lcp), the length of the rest and the rest. Lengths are written as
+//varints, 7 bits per byte. The bucket of a pattern is found with a binary search on the headers, and then the
+//bucket is scanned. The id of a key is also its key in the postings.
+//The bucket size trades space (every header is a full key) for scan time, it is a template parameter so that
+//each size can be used in the experiment templates, Front_Coded_Dictionary uses buckets of 16 keys.
+template <std::size_t bucket_size>
+class Basic_Front_Coded_Dictionary{
+public:
+  static const std::uint32_t no_key = 0xFFFFFFFF;
+
+  Basic_Front_Coded_Dictionary();
+  void insert(const std::string &pattern, std::size_t value, int text_index);
+  void freeze();
+  void build(std::vector<std::string> &keys, std::vector<std::vector<std::vector<std::size_t>>> &key_values);
+  std::uint32_t locate(const std::string &pattern);
+  std::string extract(std::uint32_t id);
+  std::uint32_t search(const std::string &pattern){return this->locate(pattern);}
+  void delete_data();
+  bool search_report(const std::string &pattern, int text_index, int print);
+  std::string get_name(){return this->name;}
+  std::size_t structure_size();
+  double bytes_per_key();
+  double extra_measurement(){return this->bytes_per_key();}
+  double get_build_time(){return this->build_time;}
+  std::vector<std::size_t> occurences(const std::string &pattern);
+private:
+  Loading_Table loading_table;
+  std::size_t keys;
+  std::string name;
+  double build_time;
+
+  std::vector<char> buckets;
+  std::vector<std::uint32_t> bucket_offsets;
+  Flat_Postings postings;
+
+  int compare_header(std::size_t bucket, const std::string &pattern);
+};
+
+typedef Basic_Front_Coded_Dictionary<16> Front_Coded_Dictionary;
+typedef Basic_Front_Coded_Dictionary<4> Front_Coded_Dictionary_4;
+typedef Basic_Front_Coded_Dictionary<64> Front_Coded_Dictionary_64;
+
+void write_varint(std::vector<char> &bytes, std::size_t value);
+std::size_t read_varint(const char **bytes);
+
+#endif
@@ -0,0 +1,88 @@
+#include "frozen_dictionary.hpp"
+
+//Inserts a key with its value in the loading table, creating it if it is the first insertion.
+//Returns 0 if the structure is already frozen, the key is not inserted then.
+bool Loading_Table::insert(const std::string &pattern, std::size_t value, int text_index){
+  if(this->frozen){
+    return 0;
+  }
+  if(this->table == nullptr){
+    this->table = new Hash_Table();
+  }
+  this->table->insert(pattern, value, text_index);
+  return 1;
+}
+
+//Copies the keys inserted so far and their values for each text, so that the structure can be built from them.
+//Returns 0 if the structure is already frozen, the keys are left empty then.
+bool Loading_Table::take_contents(std::vector<std::string> &keys, std::vector<std::vector<std::vector<std::size_t>>> &key_values){
+  if(this->frozen){
+    return 0;
+  }
+  if(this->table != nullptr){
+    this->table->copy_contents(keys, key_values);
+  }
+  return 1;
+}
+
+//Deletes the loading table, once the structure is built (or deleted), no more keys can be inserted.
+void Loading_Table::release(){
+  if(this->table != nullptr){
+    this->table->delete_data();
+    delete this->table;
+    this->table = nullptr;
+  }
+  this->frozen = 1;
+}
+
+//Returns the size of the loading table in bytes, 0 if there is none.
+std::size_t Loading_Table::structure_size(){
+  if(this->table == nullptr){
+    return 0;
+  }
+  return this->table->structure_size();
+}
+
+//Empties the postings before the values of keys keys are added.
+void Flat_Postings::start(std::size_t keys){
+  this->values.clear();
+  this->offsets.assign(1, 0);
+  this->offsets.reserve(2*keys + 1);
+}
+
+//Adds the values of the next key, for both texts.
+void Flat_Postings::add_key(const std::vector<std::vector<std::size_t>> &key_values){
+  for(int text = 0; text < 2; text++){
+    this->values.insert(this->values.end(), key_values[text].begin(), key_values[text].end());
+    this->offsets.push_back(this->values.size());
+  }
+}
+
+//Prints the values of a key, for a given text.
+void Flat_Postings::print(std::uint32_t key, int text_index){
+  for(std::size_t i = this->offsets[2*key + text_index]; i < this->offsets[2*key + text_index + 1]; i++){
+    std::cout << this->values[i] << ", ";
+  }
+}
+
+//Releases the memory left over once every key has been added.
+void Flat_Postings::shrink_to_fit(){
+  this->values.shrink_to_fit();
+  this->offsets.shrink_to_fit();
+}
+
+//Returns the size of the postings in bytes, using the capacity of the vectors.
+std::size_t Flat_Postings::structure_size(){
+  return this->values.capacity()*sizeof(std::size_t) + this->offsets.capacity()*sizeof(std::uint32_t);
+}
+
+//Returns the number of bits used by the values and the offsets, regardless of the capacity of the vectors.
+std::size_t Flat_Postings::size_in_bits(){
+  return 64*this->values.size() + 32*this->offsets.size();
+}
+
+//Releases the values and the offsets.
+void Flat_Postings::clear(){
+  std::vector<std::size_t>().swap(this->values);
+  std::vector<std::uint32_t>().swap(this->offsets);
+}
@@ -0,0 +1,48 @@
+#ifndef __FD_H_INCLUDED__
+#define __FD_H_INCLUDED__
+
+#include <string>
+#include <iostream>
+#include <vector>
+#include <cstdint>
+#include "linear_hash.hpp"
+
+//The frozen structures (Frozen_Hash_Table, Double_Array_Trie, Louds_Trie and the Front_Coded_Dictionary) are
+//immutable dictionaries compiled from the keys and values of a finished dictionary. They share their life cycle:
+//the keys are inserted in a Loading_Table until the structure is frozen, then its contents are taken out to build
+//the structure and the loading table is released. The values of the built structure are kept in a Flat_Postings.
+
+//A Loading_Table holds the insertions of a frozen structure in a regular Hash_Table, which is only created with
+//the first insertion, so a structure built directly from the keys of another dictionary never allocates it.
+class Loading_Table{
+public:
+  bool insert(const std::string &pattern, std::size_t value, int text_index);
+  bool take_contents(std::vector<std::string> &keys, std::vector<std::vector<std::vector<std::size_t>>> &key_values);
+  void release();
+  bool is_frozen(){return this->frozen;}
+  std::size_t structure_size();
+private:
+  Hash_Table *table = nullptr;
+  bool frozen = 0;
+};
+
+//A Flat_Postings keeps the values of the keys of a frozen structure, numbered from 0 in the order they are added.
+//The values of every key are stored one after the other in values, first those of text 0 and then those of text 1:
+//the values of key k for text t start at offsets[2*k + t], so counting them is a subtraction.
+class Flat_Postings{
+public:
+  void start(std::size_t keys);
+  void add_key(const std::vector<std::vector<std::size_t>> &key_values);
+  std::size_t count(std::uint32_t key, int text_index){return this->offsets[2*key + text_index + 1] - this->offsets[2*key + text_index];}
+  std::vector<std::size_t> counts(std::uint32_t key){return std::vector<std::size_t> {this->count(key, 0), this->count(key, 1)};}
+  void print(std::uint32_t key, int text_index);
+  void shrink_to_fit();
+  std::size_t structure_size();
+  std::size_t size_in_bits();
+  void clear();
+private:
+  std::vector<std::size_t> values;
+  std::vector<std::uint32_t> offsets;
+};
+
+#endif
@@ -0,0 +1,257 @@
+#include "frozen_hash.hpp"
+
+//Mixes the bits of a 64 bit value (the finalizer of splitmix64).
+std::uint64_t frozen_mix(std::uint64_t x){
+  x = (x ^ (x >> 30))*0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27))*0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+//Frozen_Hash_Table constructor. The table starts empty, the insertions are kept in the loading table
+//until freeze is called (or the table is built directly from the keys of a Hash_Table, see Hash_Table::freeze).
+Frozen_Hash_Table::Frozen_Hash_Table(){
+  this->keys = 0;
+  this->table_size = 0;
+  this->buckets = 0;
+  this->build_time = 0.0;
+  this->key_offsets.push_back(0);
+}
+
+//Builds the frozen table directly from the keys of a dictionary and their values (the keys of a Hash_Table,
+//see Hash_Table::freeze).
+Frozen_Hash_Table::Frozen_Hash_Table(std::vector<std::string> &keys, std::vector<std::vector<std::vector<std::size_t>>> &key_values){
+  this->keys = 0;
+  this->table_size = 0;
+  this->buckets = 0;
+  this->build_time = 0.0;
+  this->build(keys, key_values);
+}
+
+//Insertions are only possible before the table is frozen.
+void Frozen_Hash_Table::insert(std::string pattern, std::size_t value, int text_index){
+  if(!this->loading_table.insert(pattern, value, text_index)){
+    std::cout << "THE TABLE IS FROZEN, " << pattern << " WAS NOT INSERTED!!!" << std::endl;
+  }
+}
+
+//Builds the frozen table with the keys inserted so far.
+void Frozen_Hash_Table::freeze(){
+  std::vector<std::string> keys;
+  std::vector<std::vector<std::vector<std::size_t>>> key_values;
+  if(this->loading_table.take_contents(keys, key_values)){
+    this->build(keys, key_values);
+  }
+}
+
+//The bucket of a key is taken from the high bits of its hash (multiplying it by the number of
+//buckets and keeping the upper 64 bits of the product, which avoids the modulo).
+std::size_t Frozen_Hash_Table::bucket_of(std::uint64_t hash){
+  return ((__uint128_t)hash*this->buckets) >> 64;
+}
+
+//The slot of a key for a given pilot, in [0, table_size). The pilot is mixed before it is combined
+//with the hash, so consecutive pilots send the keys of a bucket to unrelated slots.
+std::size_t Frozen_Hash_Table::position(std::uint64_t hash, std::uint32_t pilot){
+  return ((__uint128_t)frozen_mix(hash ^ frozen_mix(pilot + 1))*this->table_size) >> 64;
+}
+
+//The final slot of a key, which is in [0, keys): the positions past keys belong to slots left
+//empty by the pilots, found in remapped_slots.
+std::size_t Frozen_Hash_Table::slot_of(std::uint64_t hash){
+  std::size_t slot = this->position(hash, this->pilots[this->bucket_of(hash)]);
+  if(slot >= this->keys){
+    slot = this->remapped_slots[slot - this->keys];
+  }
+  return slot;
+}
+
+//Builds the minimal perfect hash function over the keys and stores the keys and their values in
+//the slots it gives them. The buckets are processed from the largest to the smallest, since the large
+//ones are harder to place, and for each one the pilots 0, 1, 2... are tried until all of its keys land
+//in free slots (and in different slots from each other). The time taken is kept in build_time, in milliseconds.
+void Frozen_Hash_Table::build(std::vector<std::string> &keys, std::vector<std::vector<std::vector<std::size_t>>> &key_values){
+  auto start_time = std::chrono::steady_clock::now();
+  this->loading_table.release();
+  this->keys = keys.size();
+  this->table_size = this->keys/alpha + 1;
+  this->buckets = this->keys/keys_per_bucket + 1;
+
+  std::vector<std::uint64_t> hashes(this->keys);
+  std::vector<std::size_t> bucket_start(this->buckets + 1, 0);
+  for(std::size_t i = 0; i < this->keys; i++){
+    hashes[i] = this->hash_function(keys[i]);
+    bucket_start[this->bucket_of(hashes[i]) + 1]++;
+  }
+  for(std::size_t b = 0; b < this->buckets; b++){
+    bucket_start[b + 1] = bucket_start[b + 1] + bucket_start[b];
+  }
+  std::vector<std::size_t> bucket_keys(this->keys);
+  std::vector<std::size_t> filled(bucket_start.begin(), bucket_start.end() - 1);
+  for(std::size_t i = 0; i < this->keys; i++){
+    std::size_t b = this->bucket_of(hashes[i]);
+    bucket_keys[filled[b]] = i;
+    filled[b]++;
+  }
+  std::vector<std::size_t> bucket_order(this->buckets);
+  for(std::size_t b = 0; b < this->buckets; b++){
+    bucket_order[b] = b;
+  }
+  std::stable_sort(bucket_order.begin(), bucket_order.end(), [&bucket_start](std::size_t a, std::size_t b){
+    return bucket_start[a + 1] - bucket_start[a] > bucket_start[b + 1] - bucket_start[b];
+  });
+
+  this->pilots.assign(this->buckets, 0);
+  std::vector<bool> taken(this->table_size, 0);
+  std::vector<std::size_t> key_slots(this->keys);
+  std::vector<std::size_t> candidate_slots;
+  for(std::size_t i = 0; i < this->buckets; i++){
+    std::size_t b = bucket_order[i];
+    if(bucket_start[b + 1] == bucket_start[b]){
+      break;
+    }
+    for(std::uint32_t pilot = 0;; pilot++){
+      candidate_slots.clear();
+      bool placed = 1;
+      for(std::size_t k = bucket_start[b]; k < bucket_start[b + 1] && placed; k++){
+        std::size_t slot = this->position(hashes[bucket_keys[k]], pilot);
+        placed = !taken[slot] && std::find(candidate_slots.begin(), candidate_slots.end(), slot) == candidate_slots.end();
+        candidate_slots.push_back(slot);
+      }
+      if(placed){
+        this->pilots[b] = pilot;
+        for(std::size_t k = 0; k < candidate_slots.size(); k++){
+          taken[candidate_slots[k]] = 1;
+          key_slots[bucket_keys[bucket_start[b] + k]] = candidate_slots[k];
+        }
+        break;
+      }
+    }
+  }
+
+  //The keys placed past the first keys slots are moved to the slots that were left free before them.
+  this->remapped_slots.assign(this->table_size - this->keys, 0);
+  std::size_t free_slot = 0;
+  for(std::size_t slot = this->keys; slot < this->table_size; slot++){
+    if(taken[slot]){
+      while(taken[free_slot]){
+        free_slot++;
+      }
+      this->remapped_slots[slot - this->keys] = free_slot;
+      free_slot++;
+    }
+  }
+
+  std::vector<std::size_t> slot_keys(this->keys);
+  for(std::size_t i = 0; i < this->keys; i++){
+    std::size_t slot = key_slots[i];
+    if(slot >= this->keys){
+      slot = this->remapped_slots[slot - this->keys];
+    }
+    slot_keys[slot] = i;
+  }
+  this->key_offsets.assign(1, 0);
+  this->key_bytes.clear();
+  this->postings.start(this->keys);
+  for(std::size_t slot = 0; slot < this->keys; slot++){
+    std::size_t i = slot_keys[slot];
+    this->key_bytes.insert(this->key_bytes.end(), keys[i].begin(), keys[i].end());
+    this->key_offsets.push_back(this->key_bytes.size());
+    this->postings.add_key(key_values[i]);
+  }
+  this->key_bytes.shrink_to_fit();
+  this->postings.shrink_to_fit();
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start_time;
+  this->build_time = elapsed.count();
+}
+
+//Deletes the loading table, if the table was never frozen, and releases the arrays.
+void Frozen_Hash_Table::delete_data(){
+  this->loading_table.release();
+  std::vector<std::uint32_t>().swap(this->pilots);
+  std::vector<std::uint32_t>().swap(this->remapped_slots);
+  std::vector<char>().swap(this->key_bytes);
+  std::vector<std::uint32_t>().swap(this->key_offsets);
+  this->postings.clear();
+}
+
+//Searches for the pattern, returns its slot or keys if it is not in the table. Since the slot
+//of a key is unique, the pattern is only compared against the key stored in that slot.
+std::size_t Frozen_Hash_Table::search(const std::string &pattern){
+  if(this->keys == 0){
+    return 0;
+  }
+  std::size_t slot = this->slot_of(this->hash_function(pattern));
+  std::size_t length = this->key_offsets[slot + 1] - this->key_offsets[slot];
+  if(length == pattern.size() && std::memcmp(this->key_bytes.data() + this->key_offsets[slot], pattern.data(), length) == 0){
+    return slot;
+  }
+  return this->keys;
+}
+
+//Returns the key stored at a specified slot.
+std::string Frozen_Hash_Table::key_in_slot(std::size_t slot){
+  if(slot == this->keys){
+    return "VALUE NOT FOUND";
+  }
+  return std::string(this->key_bytes.data() + this->key_offsets[slot], this->key_offsets[slot + 1] - this->key_offsets[slot]);
+}
+
+//Reports whether the pattern is in the table.
+//If print is enabled prints information pertaining to the values associated
+//to the pattern in the given text.
+bool Frozen_Hash_Table::search_report(std::string pattern, int text_index, int print){
+  std::size_t slot = this->search(pattern);
+  if(print){
+    std::cout << pattern << " found in slot " << slot << " with " << (slot == this->keys ? 0 : this->postings.count(slot, text_index)) << " occurences: ";
+    if(slot != this->keys){
+      this->postings.print(slot, text_index);
+    }
+    std::cout << std::endl;
+  }
+  return slot != this->keys;
+}
+
+//Returns the size of the structure, in bytes. Includes the loading table if it was never frozen.
+std::size_t Frozen_Hash_Table::structure_size(){
+  std::size_t size = sizeof(Frozen_Hash_Table) + this->name.capacity()*sizeof(char);
+  size = size + (this->pilots.capacity() + this->remapped_slots.capacity() + this->key_offsets.capacity())*sizeof(std::uint32_t);
+  size = size + this->key_bytes.capacity()*sizeof(char) + this->postings.structure_size();
+  return size + this->loading_table.structure_size();
+}
+
+//Returns all occurences of the pattern, for each text.
+std::vector<std::size_t> Frozen_Hash_Table::occurences(std::string pattern){
+  std::size_t slot = this->search(pattern);
+  if(slot == this->keys){
+    return std::vector<std::size_t> {0, 0};
+  }
+  return this->postings.counts(slot);
+}
+
+//Simple example of usage, the table is built from a Hash_Table.
+void example_1_frozen(){
+  Hash_Table *Table = new Hash_Table();
+  Table->insert("SOME", 0, 0);
+  Table->insert("ABACUS", 4, 0);
+  Table->insert("SOMETHING", 16, 0);
+  Table->insert("B", 50, 0);
+  Table->insert("SOME", 40, 0);
+  Frozen_Hash_Table *Frozen = Table->freeze();
+  Table->delete_data();
+  delete Table;
+
+  Frozen->search_report("SOME",0, 1);
+  Frozen->search_report("ABACUS",0, 1);
+  Frozen->search_report("SOMETHING",0, 1);
+  Frozen->search_report("B",0, 1);
+  Frozen->search_report("SOMERSET",0, 1);
+
+  Frozen->delete_data();
+  delete Frozen;
+}
+
+//UNCOMMENT MAIN TO TEST EXAMPLES IN STANDALONE FASHION
+// int main(){
+//   example_1_frozen();
+//   return 0;
+// }
@@ -0,0 +1,59 @@
+#ifndef __F_H_INCLUDED__
+#define __F_H_INCLUDED__
+
+#include <string>
+#include <iostream>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <chrono>
+#include "frozen_dictionary.hpp"
+
+//A Frozen_Hash_Table is an immutable dictionary built over the keys of a finished Hash_Table, through a
+//minimal perfect hash function (in the style of PTHash): the keys are split in buckets and every bucket
+//gets a pilot value, chosen so that hashing the keys of the bucket with it sends them to slots that no
+//other key uses. With the pilots every key has exactly one slot, so a search computes its slot and
+//compares the key stored there once.
+//The keys are stored one after the other in key_bytes (the key of slot i starts at key_offsets[i]), and the
+//values of the key of slot i are those of key i in the postings.
+class Frozen_Hash_Table{
+public:
+  Frozen_Hash_Table();
+  Frozen_Hash_Table(std::vector<std::string> &keys, std::vector<std::vector<std::vector<std::size_t>>> &key_values);
+  void insert(std::string pattern, std::size_t value, int text_index);
+  void freeze();
+  void build(std::vector<std::string> &keys, std::vector<std::vector<std::vector<std::size_t>>> &key_values);
+  std::size_t search(const std::string &pattern);
+  void delete_data();
+  std::string key_in_slot(std::size_t slot);
+  bool search_report(std::string pattern, int text_index, int print);
+  std::string get_name(){return this->name;}
+  std::size_t structure_size();
+  double get_fill(){return 1.0;}
+  double extra_measurement(){return this->get_fill();}
+  double get_build_time(){return this->build_time;}
+  std::vector<std::size_t> occurences(std::string pattern);
+private:
+  Loading_Table loading_table;
+  std::size_t keys;
+  std::size_t table_size; //keys/alpha slots are used by the pilots, the slots past keys are remapped.
+  std::size_t buckets;
+  std::string name = "FROZEN";
+  double build_time;
+  static constexpr double alpha = 0.98;
+  static constexpr double keys_per_bucket = 5.0;
+
+  std::vector<std::uint32_t> pilots;
+  std::vector<std::uint32_t> remapped_slots;
+  std::vector<char> key_bytes;
+  std::vector<std::uint32_t> key_offsets;
+  Flat_Postings postings;
+
+  Wy_Hash hash_function;
+  std::size_t bucket_of(std::uint64_t hash);
+  std::size_t position(std::uint64_t hash, std::uint32_t pilot);
+  std::size_t slot_of(std::uint64_t hash);
+};
+
+#endif
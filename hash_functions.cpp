@@ -0,0 +1,79 @@
+#include "hash_functions.hpp"
+
+#ifdef __SSE4_2__
+#include <nmmintrin.h>
+#endif
+
+const std::uint64_t wy_secret_0 = 0xa0761d6478bd642fULL;
+const std::uint64_t wy_secret_1 = 0xe7037ed1a0b428dbULL;
+
+//Multiplies two words into 128 bits and folds the result back into 64 bits.
+std::uint64_t wy_mix(std::uint64_t a, std::uint64_t b){
+  __uint128_t product = (__uint128_t)a*b;
+  return (std::uint64_t)product ^ (std::uint64_t)(product >> 64);
+}
+
+std::size_t Wy_Hash::operator()(const std::string &key) const {
+  const char *bytes = key.data();
+  std::size_t length = key.size();
+  std::uint64_t seed = wy_secret_0 ^ length;
+  while(length > 16){
+    std::uint64_t a;
+    std::uint64_t b;
+    std::memcpy(&a, bytes, 8);
+    std::memcpy(&b, bytes + 8, 8);
+    seed = wy_mix(a ^ wy_secret_1, b ^ seed);
+    bytes = bytes + 16;
+    length = length - 16;
+  }
+  std::uint64_t words[2] = {0, 0};
+  std::memcpy(words, bytes, length);
+  return wy_mix(wy_secret_1 ^ key.size(), wy_mix(words[0] ^ wy_secret_1, words[1] ^ seed));
+}
+
+std::size_t Fnv_Hash::operator()(const std::string &key) const {
+  std::uint64_t hash = 0xcbf29ce484222325ULL;
+  for(std::size_t i = 0; i < key.size(); i++){
+    hash = (hash ^ (unsigned char)key[i])*0x100000001b3ULL;
+  }
+  return hash;
+}
+
+#ifndef __SSE4_2__
+//Builds the lookup table of the CRC32-C for every byte value, using the reflected Castagnoli polynomial.
+std::uint32_t *crc_table(){
+  static std::uint32_t table[256];
+  for(std::uint32_t byte = 0; byte < 256; byte++){
+    std::uint32_t crc = byte;
+    for(int bit = 0; bit < 8; bit++){
+      crc = (crc >> 1) ^ (0x82F63B78 & (0 - (crc & 1)));
+    }
+    table[byte] = crc;
+  }
+  return table;
+}
+#endif
+
+std::size_t Crc_Hash::operator()(const std::string &key) const {
+  const char *bytes = key.data();
+  std::size_t length = key.size();
+  std::uint64_t crc = 0xFFFFFFFF;
+#ifdef __SSE4_2__
+  while(length >= 8){
+    std::uint64_t word;
+    std::memcpy(&word, bytes, 8);
+    crc = _mm_crc32_u64(crc, word);
+    bytes = bytes + 8;
+    length = length - 8;
+  }
+  for(std::size_t i = 0; i < length; i++){
+    crc = _mm_crc32_u8(crc, bytes[i]);
+  }
+#else
+  static const std::uint32_t *table = crc_table();
+  for(std::size_t i = 0; i < length; i++){
+    crc = (crc >> 8) ^ table[(crc ^ (unsigned char)bytes[i]) & 0xFF];
+  }
+#endif
+  return (crc ^ 0xFFFFFFFF)*0x9E3779B97F4A7C15ULL;
+}
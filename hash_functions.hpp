@@ -0,0 +1,42 @@
+#ifndef __HF_H_INCLUDED__
+#define __HF_H_INCLUDED__
+
+#include <string>
+#include <functional>
+#include <cstdint>
+#include <cstring>
+
+//The hash functions that can be given to a Hash_Table. Each one is a functor that returns a 64 bit
+//hash of a string, and a suffix that is appended to the name of the tables that use it, so they
+//can be told apart in the output files.
+
+//The hash function of the standard library, used by default.
+struct Std_Hash{
+  std::size_t operator()(const std::string &key) const {return this->hash_function(key);}
+  std::string name_suffix() const {return "";}
+  std::hash<std::string> hash_function;
+};
+
+//A wyhash style hash: the key is read 16 bytes at a time, and each pair of 64 bit words is mixed
+//by multiplying them into a 128 bit value and folding its halves together. Words of up to 16
+//characters take a single multiplication, plus the final one.
+struct Wy_Hash{
+  std::size_t operator()(const std::string &key) const;
+  std::string name_suffix() const {return "_WY";}
+};
+
+//The 64 bit version of the Fowler-Noll-Vo hash (FNV-1a), which xors and multiplies one character at a time.
+struct Fnv_Hash{
+  std::size_t operator()(const std::string &key) const;
+  std::string name_suffix() const {return "_FNV";}
+};
+
+//The CRC32-C of the key, computed 8 bytes at a time with the crc32 instruction when the code is compiled
+//with SSE4.2, and with a lookup table otherwise (both give the same value). Since the crc only has 32 bits,
+//it is multiplied by an odd constant to spread it over the 64 bits of the hash.
+struct Crc_Hash{
+  std::size_t operator()(const std::string &key) const;
+  std::string name_suffix() const {return "_CRC";}
+};
+
+#endif
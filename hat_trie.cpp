@@ -0,0 +1,330 @@
+#include "hat_trie.hpp"
+
+//Hashes the characters of a suffix in place, with the same FNV-1a as the Fnv_Hash.
+std::uint64_t hat_hash(const char *suffix, std::size_t length){
+  std::uint64_t hash = 0xcbf29ce484222325ULL;
+  for(std::size_t i = 0; i < length; i++){
+    hash = (hash ^ (unsigned char)suffix[i])*0x100000001b3ULL;
+  }
+  return hash;
+}
+
+//Reads the length of the entry that starts at entry, and returns the number of bytes it takes. Lengths
+//below 255 take a single byte, longer ones are marked by a 255 byte and stored in the 4 bytes that follow.
+std::size_t read_entry_length(const char *entry, std::size_t *length){
+  if((unsigned char)entry[0] != 255){
+    *length = (unsigned char)entry[0];
+    return 1;
+  }
+  std::uint32_t long_length;
+  std::memcpy(&long_length, entry + 1, 4);
+  *length = long_length;
+  return 5;
+}
+
+//Hat_Trie constructor. A burst threshold of 1024 keys and containers of 128 slots keep about 8 keys per
+//slot before a container bursts.
+Hat_Trie::Hat_Trie() : Hat_Trie(1024, 128){
+}
+
+//The whole trie starts as a single container, which is the root until it bursts. The number of slots
+//is rounded up to a power of 2, so the slot of a suffix is taken with a mask.
+Hat_Trie::Hat_Trie(std::size_t burst_threshold, std::size_t container_slots){
+  this->burst_threshold = burst_threshold;
+  this->container_slots = 1;
+  while(this->container_slots < container_slots){
+    this->container_slots = 2*this->container_slots;
+  }
+  this->root = this->make_container();
+}
+
+//Makes a trie node with no children and no posting.
+hat_ref Hat_Trie::make_node(){
+  hat_node new_node;
+  for(std::size_t byte = 0; byte < 256; byte++){
+    new_node.children[byte] = no_node;
+  }
+  new_node.posting = no_posting;
+  this->nodes.push_back(new_node);
+  return this->nodes.size() - 1;
+}
+
+//Makes an empty container, reusing the slot of a container that burst if there is one.
+hat_ref Hat_Trie::make_container(){
+  std::uint32_t index = this->containers.size();
+  if(!this->free_containers.empty()){
+    index = this->free_containers.back();
+    this->free_containers.pop_back();
+  }else{
+    this->containers.push_back(hat_container());
+  }
+  this->containers[index].slots.assign(this->container_slots, std::vector<char>());
+  this->containers[index].size = 0;
+  return index | container_bit;
+}
+
+//Scans the slot of the suffix in the container, and returns the posting of the suffix or no_posting if it is
+//not there. Entries are skipped by their length, and only those of the same length are compared.
+std::uint32_t Hat_Trie::container_find(hat_ref container, const char *suffix, std::size_t length){
+  const hat_container &stored = this->containers[container & ~container_bit];
+  const std::vector<char> &slot = stored.slots[hat_hash(suffix, length) & (this->container_slots - 1)];
+  const char *entry = slot.data();
+  const char *end = entry + slot.size();
+  while(entry < end){
+    std::size_t entry_length = 0;
+    entry = entry + read_entry_length(entry, &entry_length);
+    if(entry_length == length && std::memcmp(entry, suffix, length) == 0){
+      std::uint32_t posting;
+      std::memcpy(&posting, entry + length, 4);
+      return posting;
+    }
+    entry = entry + entry_length + 4;
+  }
+  return no_posting;
+}
+
+//Appends an entry for a suffix (which must not be in the container) at the end of its slot.
+void Hat_Trie::container_add(hat_ref container, const char *suffix, std::size_t length, std::uint32_t posting){
+  hat_container &stored = this->containers[container & ~container_bit];
+  std::vector<char> &slot = stored.slots[hat_hash(suffix, length) & (this->container_slots - 1)];
+  if(length < 255){
+    slot.push_back((char)length);
+  }else{
+    std::uint32_t long_length = length;
+    slot.push_back((char)255);
+    slot.insert(slot.end(), (const char*)&long_length, (const char*)&long_length + 4);
+  }
+  slot.insert(slot.end(), suffix, suffix + length);
+  slot.insert(slot.end(), (const char*)&posting, (const char*)&posting + 4);
+  stored.size++;
+}
+
+//Bursts a container that went beyond the threshold: a trie node takes its place, the suffix that is empty
+//(if any) becomes the posting of the node, and every other suffix moves, without its first character, to the
+//container of the child for that character. Returns the reference of the new trie node.
+hat_ref Hat_Trie::burst(hat_ref container){
+  std::vector<std::vector<char>> old_slots;
+  old_slots.swap(this->containers[container & ~container_bit].slots);
+  this->free_containers.push_back(container & ~container_bit);
+  hat_ref new_node = this->make_node();
+  for(std::size_t i = 0; i < old_slots.size(); i++){
+    const char *entry = old_slots[i].data();
+    const char *end = entry + old_slots[i].size();
+    while(entry < end){
+      std::size_t length = 0;
+      entry = entry + read_entry_length(entry, &length);
+      std::uint32_t posting;
+      std::memcpy(&posting, entry + length, 4);
+      if(length == 0){
+        this->nodes[new_node].posting = posting;
+      }else{
+        std::uint8_t byte = (std::uint8_t)entry[0];
+        if(this->nodes[new_node].children[byte] == no_node){
+          hat_ref child = this->make_container();
+          this->nodes[new_node].children[byte] = child;
+        }
+        this->container_add(this->nodes[new_node].children[byte], entry + 1, length - 1, posting);
+      }
+      entry = entry + length + 4;
+    }
+  }
+  return new_node;
+}
+
+//Inserts a pattern. The trie nodes are followed one character at a time until the pattern ends at a trie node,
+//whose posting then takes the value, or a container is reached, which holds the rest of the pattern. If the
+//container goes beyond the burst threshold it bursts, and its new trie node replaces it in its parent.
+void Hat_Trie::insert(const std::string &pattern, std::size_t value, int text_index){
+  hat_ref node = this->root;
+  hat_ref parent = no_node;
+  std::uint8_t parent_byte = 0;
+  std::size_t depth = 0;
+  while(!this->is_container(node)){
+    if(depth == pattern.size()){
+      if(this->nodes[node].posting == no_posting){
+        this->nodes[node].posting = this->postings.add_key(value, text_index);
+      }else{
+        this->postings.add_value(this->nodes[node].posting, value, text_index);
+      }
+      return;
+    }
+    std::uint8_t byte = (std::uint8_t)pattern[depth];
+    if(this->nodes[node].children[byte] == no_node){
+      hat_ref child = this->make_container();
+      this->nodes[node].children[byte] = child;
+    }
+    parent = node;
+    parent_byte = byte;
+    node = this->nodes[node].children[byte];
+    depth++;
+  }
+  std::uint32_t posting = this->container_find(node, pattern.data() + depth, pattern.size() - depth);
+  if(posting != no_posting){
+    this->postings.add_value(posting, value, text_index);
+    return;
+  }
+  this->container_add(node, pattern.data() + depth, pattern.size() - depth, this->postings.add_key(value, text_index));
+  if(this->containers[node & ~container_bit].size > this->burst_threshold){
+    hat_ref new_node = this->burst(node);
+    if(parent == no_node){
+      this->root = new_node;
+    }else{
+      this->nodes[parent].children[parent_byte] = new_node;
+    }
+  }
+}
+
+//Frees the nodes, containers and postings of the trie.
+void Hat_Trie::delete_data(){
+  std::vector<hat_node>().swap(this->nodes);
+  std::vector<hat_container>().swap(this->containers);
+  std::vector<std::uint32_t>().swap(this->free_containers);
+  this->postings.clear();
+  this->root = no_node;
+}
+
+//Searches for the pattern, returns its posting or no_posting if it is not in the trie.
+std::uint32_t Hat_Trie::search(const std::string &pattern){
+  hat_ref node = this->root;
+  std::size_t depth = 0;
+  while(node != no_node && !this->is_container(node)){
+    if(depth == pattern.size()){
+      return this->nodes[node].posting;
+    }
+    node = this->nodes[node].children[(std::uint8_t)pattern[depth]];
+    depth++;
+  }
+  if(node == no_node){
+    return no_posting;
+  }
+  return this->container_find(node, pattern.data() + depth, pattern.size() - depth);
+}
+
+//Finds the depth of the trie, counting the container at the bottom of the deepest path.
+int Hat_Trie::find_depth(hat_ref node){
+  if(node == no_node){
+    return 0;
+  }
+  if(this->is_container(node)){
+    return 1;
+  }
+  int depth = 0;
+  for(std::size_t byte = 0; byte < 256; byte++){
+    depth = std::max(depth, this->find_depth(this->nodes[node].children[byte]));
+  }
+  return 1 + depth;
+}
+
+//Appends the keys below node, in lexicographic order, to keys. prefix holds the characters that lead to
+//node. The key that ends at a trie node comes before those of its children, which are visited in the
+//order of their characters, and the suffixes of a container are sorted before being appended.
+void Hat_Trie::collect_keys(hat_ref node, std::string &prefix, std::vector<std::string> &keys){
+  if(node == no_node){
+    return;
+  }
+  if(this->is_container(node)){
+    std::vector<std::string> suffixes;
+    const hat_container &stored = this->containers[node & ~container_bit];
+    for(std::size_t i = 0; i < stored.slots.size(); i++){
+      const char *entry = stored.slots[i].data();
+      const char *end = entry + stored.slots[i].size();
+      while(entry < end){
+        std::size_t length = 0;
+        entry = entry + read_entry_length(entry, &length);
+        suffixes.push_back(prefix + std::string(entry, length));
+        entry = entry + length + 4;
+      }
+    }
+    std::sort(suffixes.begin(), suffixes.end());
+    keys.insert(keys.end(), suffixes.begin(), suffixes.end());
+    return;
+  }
+  if(this->nodes[node].posting != no_posting){
+    keys.push_back(prefix);
+  }
+  for(std::size_t byte = 0; byte < 256; byte++){
+    prefix.push_back((char)byte);
+    this->collect_keys(this->nodes[node].children[byte], prefix, keys);
+    prefix.pop_back();
+  }
+}
+
+//Returns all the keys of the trie, in lexicographic order (comparing characters as unsigned bytes).
+std::vector<std::string> Hat_Trie::keys_in_order(){
+  std::vector<std::string> keys;
+  std::string prefix = "";
+  this->collect_keys(this->root, prefix, keys);
+  return keys;
+}
+
+//Reports whether the pattern is in the trie.
+//If print is enabled prints information pertaining to the values associated
+//to the pattern in the given text.
+bool Hat_Trie::search_report(const std::string &pattern, int text_index, int print){
+  std::uint32_t posting = this->search(pattern);
+  if(posting == no_posting){
+    return 0;
+  }
+  if(print){
+    std::cout << pattern << " found with " << this->postings.count(posting, text_index) << " occurences at positions: ";
+    this->postings.print(posting, text_index);
+    std::cout << std::endl;
+  }
+  return 1;
+}
+
+//Returns the size of the structure, in bytes: the trie nodes, the containers with their slots and the postings.
+std::size_t Hat_Trie::structure_size(){
+  std::size_t size = sizeof(Hat_Trie) + this->name.capacity()*sizeof(char) + this->nodes.capacity()*sizeof(hat_node);
+  size = size + this->containers.capacity()*sizeof(hat_container) + this->free_containers.capacity()*sizeof(std::uint32_t);
+  for(std::size_t i = 0; i < this->containers.size(); i++){
+    size = size + this->containers[i].slots.capacity()*sizeof(std::vector<char>);
+    for(std::size_t j = 0; j < this->containers[i].slots.size(); j++){
+      size = size + this->containers[i].slots[j].capacity();
+    }
+  }
+  size = size + this->postings.structure_size();
+  return size;
+}
+
+//Returns all occurences of the pattern, for each text.
+std::vector<std::size_t> Hat_Trie::occurences(const std::string &pattern){
+  std::uint32_t posting = this->search(pattern);
+  if(posting == no_posting){
+    return std::vector<std::size_t> {0, 0};
+  }
+  return std::vector<std::size_t> {this->postings.count(posting, 0), this->postings.count(posting, 1)};
+}
+
+//Simple example of usage, with a burst threshold of 2 so that the root bursts, and an ordered traversal.
+void example_1_hat_trie(){
+  Hat_Trie *Trie = new Hat_Trie(2, 4);
+  Trie->insert("hola", 0, 0);
+  Trie->insert("ola", 1, 0);
+  Trie->insert("holograma", 2, 0);
+  Trie->insert("holografia", 3, 0);
+  Trie->insert("ho", 4, 0);
+  Trie->insert("h", 5, 0);
+  Trie->insert("hola", 50, 0);
+
+  Trie->search_report("hola", 0, 1);
+  Trie->search_report("holograma", 0, 1);
+  Trie->search_report("ho", 0, 1);
+  Trie->search_report("h", 0, 1);
+  Trie->search_report("hol", 0, 1);
+
+  std::vector<std::string> keys = Trie->keys_in_order();
+  for(std::size_t i = 0; i < keys.size(); i++){
+    std::cout << keys[i] << " ";
+  }
+  std::cout << std::endl;
+
+  Trie->delete_data();
+  delete Trie;
+}
+
+//UNCOMMENT MAIN TO TEST EXAMPLES IN STANDALONE FASHION
+// int main(){
+//   example_1_hat_trie();
+//   return 0;
+// }
@@ -0,0 +1,74 @@
+#ifndef __HT_H_INCLUDED__
+#define __HT_H_INCLUDED__
+
+#include <string>
+#include <iostream>
+#include <algorithm>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include "postings.hpp"
+
+//Nodes of the Hat_Trie are referred to by 32 bit references (hat_ref): if the highest bit is set the
+//rest is the index of a container, otherwise it is the index of a trie node. no_node means there is none.
+typedef std::uint32_t hat_ref;
+
+//A trie node has a child for every byte, which is either a trie node or a container holding the suffixes
+//of the keys that continue with that byte. posting is the posting of the key that ends at the node, if any.
+struct hat_node{
+  hat_ref children[256];
+  std::uint32_t posting;
+};
+
+//An array hash container. The suffixes it holds are hashed to one of its slots, and each slot is a single
+//contiguous array of entries (length of the suffix, its characters and its posting), so that scanning a slot
+//touches consecutive memory instead of following a pointer per key. size is the number of suffixes held.
+struct hat_container{
+  std::vector<std::vector<char>> slots;
+  std::uint32_t size;
+};
+
+//Hat_Trie class declaration, exposes the same interface as the Patricia_Tree so that it can be used
+//in the experiment templates, plus keys_in_order.
+class Hat_Trie{
+public:
+  static const hat_ref no_node = 0xFFFFFFFF;
+  static const hat_ref container_bit = 0x80000000;
+  static const std::uint32_t no_posting = 0xFFFFFFFF;
+
+  Hat_Trie();
+  Hat_Trie(std::size_t burst_threshold, std::size_t container_slots);
+  void insert(const std::string &pattern, std::size_t value, int text_index);
+  void delete_data();
+  std::uint32_t search(const std::string &pattern);
+  bool search_report(const std::string &pattern, int text_index, int print);
+  std::string get_name(){return this->name;}
+  std::size_t structure_size();
+  double extra_measurement(){return this->find_depth(this->root);}
+  std::vector<std::size_t> occurences(const std::string &pattern);
+  std::vector<std::string> keys_in_order();
+private:
+  hat_ref root;
+  std::size_t burst_threshold;
+  std::size_t container_slots;
+  std::vector<hat_node> nodes;
+  std::vector<hat_container> containers;
+  std::vector<std::uint32_t> free_containers;
+  //The values of each key, for both texts, stored as in the Patricia_Tree. Entries refer to them by index.
+  Postings_Table postings;
+  std::string name = "HAT";
+
+  bool is_container(hat_ref node){return (node & container_bit) != 0;}
+  hat_ref make_node();
+  hat_ref make_container();
+  std::uint32_t container_find(hat_ref container, const char *suffix, std::size_t length);
+  void container_add(hat_ref container, const char *suffix, std::size_t length, std::uint32_t posting);
+  hat_ref burst(hat_ref container);
+  int find_depth(hat_ref node);
+  void collect_keys(hat_ref node, std::string &prefix, std::vector<std::string> &keys);
+};
+
+std::uint64_t hat_hash(const char *suffix, std::size_t length);
+std::size_t read_entry_length(const char *entry, std::size_t *length);
+
+#endif
@@ -1,166 +1,534 @@
 #include "linear_hash.hpp"
+#include "frozen_hash.hpp"
 
 //Hash_Table constructor, in order to make it more competitive to the trees we start with a small
-//size of 100. Every time the load factor grows beyond 0.4 we double the table size.
-//A table is made of hash_slots, which contain a string key and a vector of vectors to store the values
-//for each text.
+//size of 128. Every time the load factor grows beyond 0.4 we double the table size, so the size is
+//always a power of 2 and the slot of a hash is taken with a mask instead of a modulo.
+//A table is made of hash_slots, which point to the entries that contain the key and a vector of vectors
+//to store the values for each text. Since the slots are plain integers, the table is allocated zeroed,
+//which makes every slot empty.
 //We keep a different counter for stored_elements (which counts the number of hash_slots being used) and
 //inserted (which counts the number of insertions performed), because a single hash_slot could store all
 //inserted values if they all corresponded to the same key, this comes in handy to compute the total size.
-Hash_Table::Hash_Table(){ //since each element is a pointer to a char* array we pay 4 bytes per item.
-  this->table_size = 100;
+template <class hasher>
+Basic_Hash_Table<hasher>::Basic_Hash_Table(){
+  this->table_size = 128;
+  this->name = "HASH" + this->hash_function.name_suffix();
   this->stored_elements = 0;
-  this->hash_table = new hash_slot[this->table_size + 1];
-  this->hash_table[this->table_size].key = "VALUE NOT FOUND";
+  this->hash_table = new hash_slot[this->table_size + 1]();
   this->inserted = 0;
+  this->rehash_time = 0.0;
+  this->entries.push_back(hash_entry());
+  this->entries[0].hash = 0;
+  this->entries[0].key = this->make_key_reference("VALUE NOT FOUND");
+  this->entries[0].text_position.push_back(std::vector<std::size_t> {});
+  this->entries[0].text_position.push_back(std::vector<std::size_t> {});
+#ifdef HASH_TABLE_STATISTICS
+  this->creation_time = std::chrono::steady_clock::now();
+#endif
 }
 
-//Returns the value of the hash function in modulo table_size;
-std::size_t Hash_Table::hash_value(std::string pattern){
-  return this->hash_function(pattern)%this->table_size;
+//Constructor for a Hash_Table that can resize incrementally. Instead of rehashing all the
+//entries in the insertion that surpasses the load factor, the old table is kept alive and
+//every following insertion or search moves slots_per_migration_step of its slots to the new
+//table, until the old table is empty and can be deleted. This bounds the work of any single operation.
+template <class hasher>
+Basic_Hash_Table<hasher>::Basic_Hash_Table(bool incremental_resize) : Basic_Hash_Table(){
+  this->incremental_resize = incremental_resize;
+  if(incremental_resize){
+    this->name = "HASH_INC" + this->hash_function.name_suffix();
+  }
+}
+
+//Returns the full value of the hash function, the starting slot is given by its lowest bits.
+template <class hasher>
+std::size_t Basic_Hash_Table<hasher>::hash_value(const std::string &pattern){
+  return this->hash_function(pattern);
 }
 
 //Returns the load factor of the table.
-double Hash_Table::get_fill(){
+template <class hasher>
+double Basic_Hash_Table<hasher>::get_fill(){
   return this->stored_elements/(double)this->table_size;
 }
 
-//Probes the table to find a free slot, it starts at the hash_value given by the
-//hash function and then advances in linear fashion, wrapping around the borders
+//Builds the reference that a pattern would have in the table. Short patterns are complete,
+//long patterns only have their length, since they have no place in the arena yet.
+template <class hasher>
+key_reference Basic_Hash_Table<hasher>::make_key_reference(const std::string &pattern){
+  key_reference key;
+  std::memset(key.bytes, 0, sizeof(key.bytes));
+  if(pattern.size() < sizeof(key.bytes)){
+    std::memcpy(key.bytes, pattern.data(), pattern.size());
+    key.bytes[15] = (unsigned char)pattern.size();
+  }else{
+    std::uint32_t length = pattern.size();
+    std::memcpy(key.bytes + 4, &length, sizeof(length));
+    key.bytes[15] = long_key;
+  }
+  return key;
+}
+
+//Builds the reference of a pattern that is being inserted, appending it to the arena if it is long.
+template <class hasher>
+key_reference Basic_Hash_Table<hasher>::store_key(const std::string &pattern){
+  key_reference key = this->make_key_reference(pattern);
+  if(key.bytes[15] == long_key){
+    std::uint32_t offset = this->key_arena.size();
+    std::memcpy(key.bytes, &offset, sizeof(offset));
+    this->key_arena.insert(this->key_arena.end(), pattern.begin(), pattern.end());
+  }
+  return key;
+}
+
+//Rebuilds the key a reference points to.
+template <class hasher>
+std::string Basic_Hash_Table<hasher>::key_string(const key_reference &key){
+  if(key.bytes[15] != long_key){
+    return std::string((const char*)key.bytes, key.bytes[15]);
+  }
+  std::uint32_t offset = 0;
+  std::uint32_t length = 0;
+  std::memcpy(&offset, key.bytes, sizeof(offset));
+  std::memcpy(&length, key.bytes + 4, sizeof(length));
+  return std::string(this->key_arena.data() + offset, length);
+}
+
+//Checks whether an entry holds the pattern, whose hash and reference (probe_key) are given.
+//For short patterns the 16 bytes of the references are compared as two words, which also compares
+//the lengths, for long patterns the characters in the arena are compared with a single memcmp.
+template <class hasher>
+bool Basic_Hash_Table<hasher>::same_key(const hash_entry &entry, std::size_t hash, const key_reference &probe_key, const std::string &pattern){
+  if(entry.hash != hash){
+    return 0;
+  }
+  if(probe_key.bytes[15] != long_key){
+    std::uint64_t probe_words[2];
+    std::uint64_t entry_words[2];
+    std::memcpy(probe_words, probe_key.bytes, sizeof(probe_words));
+    std::memcpy(entry_words, entry.key.bytes, sizeof(entry_words));
+    return ((probe_words[0] ^ entry_words[0]) | (probe_words[1] ^ entry_words[1])) == 0;
+  }
+  if(entry.key.bytes[15] != long_key || std::memcmp(entry.key.bytes + 4, probe_key.bytes + 4, 4) != 0){
+    return 0;
+  }
+  std::uint32_t offset = 0;
+  std::memcpy(&offset, entry.key.bytes, sizeof(offset));
+  return std::memcmp(this->key_arena.data() + offset, pattern.data(), pattern.size()) == 0;
+}
+
+//Probes the table to find a free slot, it starts at the hash value given by the
+//hash function (masked by table_size - 1) and then advances in linear fashion, wrapping around the borders
 //of the table. Since the load factor is kept <= 0.4 this will always find a slot.
-std::size_t Hash_Table::probe_free_slot(std::size_t hash_value, hash_slot *hash_table_to_probe, std::string pattern){
-  std::size_t slot = hash_value;
-  while(hash_table_to_probe[slot].key != ""){
-    if (hash_table_to_probe[slot].key == pattern){
+//The hash tags stored in the slots are compared first, so the entries are only visited when the tags match.
+template <class hasher>
+std::size_t Basic_Hash_Table<hasher>::probe_free_slot(std::size_t hash, const key_reference &probe_key, const std::string &pattern){
+  std::uint32_t hash_tag = hash >> 32;
+  std::size_t slot = hash & (this->table_size - 1);
+  while(this->hash_table[slot].entry != 0){
+    if (this->hash_table[slot].hash_tag == hash_tag && this->same_key(this->entries[this->hash_table[slot].entry], hash, probe_key, pattern)){
       break;
     }
-    slot = (slot+1)%table_size;
+    slot = (slot+1) & (this->table_size - 1);
   }
   return slot;
 }
 
-//In case we need to expand the table this function rehashes the old hash_slots
-//to the new table.
-void Hash_Table::rehash_entries(hash_slot *old_table, hash_slot *new_table){
-  std::size_t original_size = this->table_size/2;
-  new_table[this->table_size].key = "VALUE NOT FOUND";
-  for(std::size_t i = 0; i < original_size ; i++ ){
-    if(old_table[i].key != ""){
-      new_table[this->probe_free_slot(this->hash_value(old_table[i].key), new_table, old_table[i].key)] = old_table[i];
-    }
+//Places an entry, which is known not to be in the table, in the first empty slot after its starting slot.
+template <class hasher>
+void Basic_Hash_Table<hasher>::place_entry(std::uint32_t entry, hash_slot *table, std::size_t size){
+  std::size_t hash = this->entries[entry].hash;
+  std::size_t slot = hash & (size - 1);
+  while(table[slot].entry != 0){
+    slot = (slot+1) & (size - 1);
+  }
+  table[slot].entry = entry;
+  table[slot].hash_tag = hash >> 32;
+}
+
+//In case we need to expand the table this function places all the entries in the new table.
+//The stored hash gives the new starting slot, so no key is hashed again, and since the entries
+//do not move only their indices are written to the new table.
+template <class hasher>
+void Basic_Hash_Table<hasher>::rehash_entries(hash_slot *new_table){
+  for(std::size_t entry = 1; entry < this->entries.size(); entry++){
+    this->place_entry(entry, new_table, this->table_size);
   }
 }
 
 //This function checks the load factor, and if the threshold has been surpassed then
-//it doubles the table and rehashes the elements.
-void Hash_Table::check_fill_rate(){
+//it doubles the table and rehashes the elements. The time spent doing so is accumulated
+//in rehash_time, in milliseconds.
+//When resizing incrementally it advances the migration in progress, and once the threshold
+//is surpassed it only starts a new migration. The new table reaches the threshold after
+//0.4*old_table_size more insertions, which migrate slots_per_migration_step (4) slots each, so a
+//migration is always finished before the next one is due, the loop is only a safeguard.
+template <class hasher>
+void Basic_Hash_Table<hasher>::check_fill_rate(){
+  if (this->old_table != nullptr){
+    this->migration_step();
+  }
   if ((( this->stored_elements + 1)/(double)this->table_size) > 0.4){
-    this->table_size = 2*this->table_size;
-    hash_slot *new_table = new hash_slot[this->table_size + 1];
-    this->rehash_entries(this->hash_table, new_table);
-    delete[] this->hash_table;
-    this->hash_table = new_table;
+    auto start_time = std::chrono::steady_clock::now();
+    if (this->incremental_resize){
+      while(this->old_table != nullptr){
+        this->migration_step();
+      }
+      this->start_migration();
+    }else{
+      this->table_size = 2*this->table_size;
+      hash_slot *new_table = new hash_slot[this->table_size + 1]();
+      this->rehash_entries(new_table);
+      delete[] this->hash_table;
+      this->hash_table = new_table;
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start_time;
+    this->rehash_time = this->rehash_time + elapsed.count();
+#ifdef HASH_TABLE_STATISTICS
+    std::chrono::duration<double, std::milli> since_creation = start_time - this->creation_time;
+    this->statistics.rehashes++;
+    this->statistics.resize_timestamps.push_back(since_creation.count());
+#endif
+  }
+}
+
+//Replaces the table by an empty one of twice the size and keeps the current one as old_table.
+//The migration starts at an empty slot of the old table, which no probe sequence goes through,
+//so moving the slots in order never leaves a key of the old table out of reach (see search_old_table).
+template <class hasher>
+void Basic_Hash_Table<hasher>::start_migration(){
+  this->old_table = this->hash_table;
+  this->old_table_size = this->table_size;
+  this->migration_start = 0;
+  while(this->old_table[this->migration_start].entry != 0){
+    this->migration_start++;
+  }
+  this->migrated_slots = 0;
+  this->table_size = 2*this->table_size;
+  this->hash_table = new hash_slot[this->table_size + 1]();
+}
+
+//Moves the next slots_per_migration_step slots of the old table to the new one, using the stored
+//hashes, and deletes the old table once all of its slots have been moved.
+template <class hasher>
+void Basic_Hash_Table<hasher>::migration_step(){
+  auto start_time = std::chrono::steady_clock::now();
+  for(std::size_t i = 0; i < this->slots_per_migration_step && this->migrated_slots < this->old_table_size; i++){
+    hash_slot &old_slot = this->old_table[(this->migration_start + this->migrated_slots) & (this->old_table_size - 1)];
+    if(old_slot.entry != 0){
+      this->place_entry(old_slot.entry, this->hash_table, this->table_size);
+      old_slot.entry = 0;
+    }
+    this->migrated_slots++;
+  }
+  if(this->migrated_slots == this->old_table_size){
+    delete[] this->old_table;
+    this->old_table = nullptr;
+    this->old_table_size = 0;
+  }
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start_time;
+  this->rehash_time = this->rehash_time + elapsed.count();
+}
+
+//Checks whether a slot of the old table has already been moved to the new table.
+template <class hasher>
+bool Basic_Hash_Table<hasher>::is_migrated(std::size_t old_slot){
+  return ((old_slot + this->old_table_size - this->migration_start) & (this->old_table_size - 1)) < this->migrated_slots;
+}
+
+//Searches for the pattern in the old table, returns its slot or old_table_size if it is not there.
+//The migrated slots are empty now, but every slot between them and the first slot not yet migrated
+//was occupied when the migration started (a probe sequence cannot cross migration_start, which was empty),
+//so a search that starts at a migrated slot can continue from the first slot not yet migrated.
+template <class hasher>
+std::size_t Basic_Hash_Table<hasher>::search_old_table(std::size_t hash, const key_reference &probe_key, const std::string &pattern){
+  std::uint32_t hash_tag = hash >> 32;
+  std::size_t slot = hash & (this->old_table_size - 1);
+  if(this->is_migrated(slot)){
+    slot = (this->migration_start + this->migrated_slots) & (this->old_table_size - 1);
+  }
+  while(this->old_table[slot].entry != 0){
+    if(this->old_table[slot].hash_tag == hash_tag && this->same_key(this->entries[this->old_table[slot].entry], hash, probe_key, pattern)){
+      return slot;
+    }
+    slot = (slot+1) & (this->old_table_size - 1);
   }
+  return this->old_table_size;
+}
+
+//search returns the slots of the old table after the slots of the table (and its not found slot),
+//this method gives back the hash_slot that corresponds to any value returned by search.
+template <class hasher>
+hash_slot &Basic_Hash_Table<hasher>::slot_reference(std::size_t slot){
+  if(slot > this->table_size){
+    return this->old_table[slot - this->table_size - 1];
+  }
+  return this->hash_table[slot];
 }
 
 //Checks whether the insertion to a hash_slot is the first, for accounting purposes.
-bool Hash_Table::first_insertion(std::size_t slot){
-  return (this->hash_table[slot].text_position.size() == 0);
+template <class hasher>
+bool Basic_Hash_Table<hasher>::first_insertion(std::size_t slot){
+  return (this->hash_table[slot].entry == 0);
 }
 
 //Insertion function, augments the inserted value by one and the stored value by one if
 //the pattern was not previously found in the table. It also checks that the load factor
-//be within bounds. If it is a first insertion then the hash_slot must be given
+//be within bounds. If it is a first insertion then an entry is made for the pattern, with
 //the vectors to store the values per text, if it is not a first insertion then the value
 //is just added to the corresponding vector.
-void Hash_Table::insert(std::string pattern, std::size_t value, int text_index){
+template <class hasher>
+void Basic_Hash_Table<hasher>::insert(std::string pattern, std::size_t value, int text_index){
   this->inserted++;
   this->check_fill_rate();
-  std::size_t slot = this->probe_free_slot(this->hash_value(pattern), this->hash_table, pattern);
+  std::size_t hash = this->hash_value(pattern);
+  key_reference probe_key = this->make_key_reference(pattern);
+  if(this->old_table != nullptr){ //keys that were not migrated yet are found through the old table.
+    std::size_t old_slot = this->search_old_table(hash, probe_key, pattern);
+    if(old_slot != this->old_table_size){
+      this->entries[this->old_table[old_slot].entry].text_position[text_index].push_back(value);
+      return;
+    }
+  }
+  std::size_t slot = this->probe_free_slot(hash, probe_key, pattern);
   if(this->first_insertion(slot)){
-    this->hash_table[slot].text_position.push_back(std::vector<std::size_t> {});
-    this->hash_table[slot].text_position.push_back(std::vector<std::size_t> {});
+    this->entries.push_back(hash_entry());
+    hash_entry &entry = this->entries.back();
+    entry.hash = hash;
+    entry.key = this->store_key(pattern);
+    entry.text_position.push_back(std::vector<std::size_t> {});
+    entry.text_position.push_back(std::vector<std::size_t> {});
+    this->hash_table[slot].entry = this->entries.size() - 1;
+    this->hash_table[slot].hash_tag = hash >> 32;
     this->stored_elements++;
   }
-  this->hash_table[slot].key = pattern;
-  this->hash_table[slot].text_position[text_index].push_back(value);
+  this->entries[this->hash_table[slot].entry].text_position[text_index].push_back(value);
 }
 
-//Deletes the hash_table array.
-void Hash_Table::delete_data(){
+//Deletes the hash_table array, and the old table if a migration was in progress,
+//and releases the entries and the key arena.
+template <class hasher>
+void Basic_Hash_Table<hasher>::delete_data(){
   delete[] this->hash_table;
+  delete[] this->old_table;
+  std::vector<hash_entry>().swap(this->entries);
+  std::vector<char>().swap(this->key_arena);
 }
 
 //Searches for the pattern in the table using the hash value of the hash function
-//as the first spot to look, then inspects linearly.
-std::size_t Hash_Table::search(std::string pattern){
-  std::size_t start_position = this->hash_value(pattern);
-  while(this->hash_table[start_position].key != ""){
-    if(this->hash_table[start_position].key == pattern){
-      return start_position;
+//as the first spot to look, then inspects linearly. Just like probe_free_slot, only
+//the slots that store the same hash tag have their entry compared.
+//During an incremental resize the search also advances the migration, and looks for the
+//pattern in the old table if it is not in the new one (see slot_reference).
+template <class hasher>
+std::size_t Basic_Hash_Table<hasher>::search(const std::string &pattern){
+  if(this->old_table != nullptr){
+    this->migration_step();
+  }
+  std::size_t hash = this->hash_value(pattern);
+  key_reference probe_key = this->make_key_reference(pattern);
+  std::size_t start_position = this->probe_free_slot(hash, probe_key, pattern);
+  if(this->hash_table[start_position].entry != 0){
+#ifdef HASH_TABLE_STATISTICS
+    this->record_search(this->probe_length(hash, start_position, this->table_size), 1);
+#endif
+    return start_position;
+  }
+  if(this->old_table != nullptr){
+    std::size_t old_slot = this->search_old_table(hash, probe_key, pattern);
+    if(old_slot != this->old_table_size){
+#ifdef HASH_TABLE_STATISTICS
+      this->record_search(this->probe_length(hash, old_slot, this->old_table_size), 1);
+#endif
+      return this->table_size + 1 + old_slot;
     }
-    start_position = (start_position+1)%this->table_size;
   }
+#ifdef HASH_TABLE_STATISTICS
+  this->record_search(this->probe_length(hash, start_position, this->table_size), 0);
+#endif
   return this->table_size;
 }
 
+//Reports, in out, whether each of the patterns is in the table. Instead of resolving the patterns
+//one after the other, which makes every search wait for the cache miss of its starting slot, all the
+//patterns are hashed first and their starting slots (and then the entries those slots point to) are
+//prefetched, so the misses of the whole batch overlap before any pattern is compared.
+//During an incremental resize the patterns are searched one at a time, to keep migrating the table.
+template <class hasher>
+void Basic_Hash_Table<hasher>::search_batch(const std::vector<std::string> &patterns, std::vector<bool> &out){
+  out.resize(patterns.size());
+  if(this->old_table != nullptr){
+    for(std::size_t i = 0; i < patterns.size(); i++){
+      out[i] = this->slot_reference(this->search(patterns[i])).entry != 0;
+    }
+    return;
+  }
+  std::vector<std::size_t> hashes(patterns.size());
+  for(std::size_t i = 0; i < patterns.size(); i++){
+    hashes[i] = this->hash_value(patterns[i]);
+    __builtin_prefetch(&this->hash_table[hashes[i] & (this->table_size - 1)]);
+  }
+  for(std::size_t i = 0; i < patterns.size(); i++){
+    __builtin_prefetch(&this->entries[this->hash_table[hashes[i] & (this->table_size - 1)].entry]);
+  }
+  for(std::size_t i = 0; i < patterns.size(); i++){
+    std::size_t slot = this->probe_free_slot(hashes[i], this->make_key_reference(patterns[i]), patterns[i]);
+    out[i] = this->hash_table[slot].entry != 0;
+#ifdef HASH_TABLE_STATISTICS
+    this->record_search(this->probe_length(hashes[i], slot, this->table_size), out[i]);
+#endif
+  }
+}
+
 //Returns the key stored at a specified slot.
-std::string Hash_Table::key_in_slot(std::size_t slot){
-  return this->hash_table[slot].key;
+template <class hasher>
+std::string Basic_Hash_Table<hasher>::key_in_slot(std::size_t slot){
+  return this->key_string(this->entries[this->slot_reference(slot).entry].key);
 }
 
 //Prints all the values stored at a given slot, for a given text.
-void Hash_Table::print_positions(std::size_t slot, int text_index){
-  for(int i = 0; i < this->hash_table[slot].text_position[text_index].size(); i++){
-    std::cout << hash_table[slot].text_position[text_index][i] << ", ";
+template <class hasher>
+void Basic_Hash_Table<hasher>::print_positions(std::size_t slot, int text_index){
+  hash_entry &entry = this->entries[this->slot_reference(slot).entry];
+  for(int i = 0; i < entry.text_position[text_index].size(); i++){
+    std::cout << entry.text_position[text_index][i] << ", ";
   }
 }
 
 //Reports whether the pattern is in the table.
 //If print is enabled prints information pertaining to the values associated
 //to the pattern in the given text.
-bool Hash_Table::search_report(std::string pattern, int text_index, int print){
+template <class hasher>
+bool Basic_Hash_Table<hasher>::search_report(std::string pattern, int text_index, int print){
   std::size_t slot = this->search(pattern);
   if (print){
-  std::cout << pattern << " found in slot " << slot << " with " << this->hash_table[slot].text_position[text_index].size() << " occurences: ";
+  std::cout << pattern << " found in slot " << slot << " with " << this->entries[this->slot_reference(slot).entry].text_position[text_index].size() << " occurences: ";
   this->print_positions(slot, text_index);
   std::cout << std::endl;
   }
-  if (pattern == this->hash_table[slot].key){
+  if (this->slot_reference(slot).entry != 0){
     return 1;
   }
   return 0;
 }
 
-//Computes the total size used by a slot.
-std::size_t Hash_Table::slot_size(struct hash_slot slot){
-  std::size_t size = sizeof(struct hash_slot);
-  if (slot.key != ""){
-    size = size + slot.key.capacity();
-    size = size + slot.text_position.capacity()*sizeof(std::vector<std::size_t>);
-    // std::cout << "accesing arrays " << std::endl;
-    size = size + (slot.text_position[0].capacity() + slot.text_position[1].capacity())*sizeof(std::size_t);
-    // std::cout << "done accesing" << std::endl;
-  }
+//Computes the total size used by the values of an entry, the entry itself is counted with the vector of entries.
+template <class hasher>
+std::size_t Basic_Hash_Table<hasher>::entry_size(const hash_entry &entry){
+  std::size_t size = entry.text_position.capacity()*sizeof(std::vector<std::size_t>);
+  size = size + (entry.text_position[0].capacity() + entry.text_position[1].capacity())*sizeof(std::size_t);
   return size;
 }
 
-//Returns the size of the structure, in bytes.
-std::size_t Hash_Table::structure_size(){
-  //We have to account for the node that will not be checked.
-  std::size_t hash_slot_info = sizeof(Hash_Table) + this->name.capacity()*sizeof(char) + this->hash_table[this->table_size].key.capacity()*sizeof(std::size_t) + sizeof(struct hash_slot);
-  for(int i = 0; i < this->table_size; i++){
-    hash_slot_info = hash_slot_info + this->slot_size(this->hash_table[i]);
+//Returns the size of the structure, in bytes: the slots (including the one that is never checked),
+//the entries with their values and the key arena.
+template <class hasher>
+std::size_t Basic_Hash_Table<hasher>::structure_size(){
+  std::size_t hash_slot_info = sizeof(Basic_Hash_Table<hasher>) + this->name.capacity()*sizeof(char) + (this->table_size + 1)*sizeof(struct hash_slot);
+  if(this->old_table != nullptr){
+    hash_slot_info = hash_slot_info + (this->old_table_size + 1)*sizeof(struct hash_slot);
+  }
+  hash_slot_info = hash_slot_info + this->entries.capacity()*sizeof(struct hash_entry) + this->key_arena.capacity()*sizeof(char);
+  for(std::size_t entry = 0; entry < this->entries.size(); entry++){
+    hash_slot_info = hash_slot_info + this->entry_size(this->entries[entry]);
   }
   return hash_slot_info;
 }
 
 //Returns all occurences of the pattern, for each text.
-std::vector<std::size_t> Hash_Table::occurences(std::string pattern){
-  std::size_t slot = this->search(pattern);
-  return std::vector<std::size_t> {this->hash_table[slot].text_position[0].size(), this->hash_table[slot].text_position[1].size()};
+template <class hasher>
+std::vector<std::size_t> Basic_Hash_Table<hasher>::occurences(std::string pattern){
+  hash_entry &entry = this->entries[this->slot_reference(this->search(pattern)).entry];
+  return std::vector<std::size_t> {entry.text_position[0].size(), entry.text_position[1].size()};
 }
 
+//Returns the number of slots probed to reach a slot, starting at the starting slot of a hash, in a table of the given size.
+template <class hasher>
+std::size_t Basic_Hash_Table<hasher>::probe_length(std::size_t hash, std::size_t slot, std::size_t size){
+  return ((slot + size - (hash & (size - 1))) & (size - 1)) + 1;
+}
+
+#ifdef HASH_TABLE_STATISTICS
+//Adds a search that probed the given number of slots to the histogram of successful or failed searches.
+template <class hasher>
+void Basic_Hash_Table<hasher>::record_search(std::size_t probes, bool found){
+  std::vector<std::size_t> &histogram = found ? this->statistics.hit_probe_lengths : this->statistics.miss_probe_lengths;
+  if(histogram.size() <= probes){
+    histogram.resize(probes + 1, 0);
+  }
+  histogram[probes]++;
+}
+#endif
+
+//Returns the statistics of the table. The histograms, the number of rehashes and the timestamps of the resizes
+//are only counted when the code is compiled with HASH_TABLE_STATISTICS defined (otherwise they are empty), so
+//they cost nothing by default. The largest cluster (run of consecutive used slots) is computed here, over the table.
+template <class hasher>
+hash_table_statistics Basic_Hash_Table<hasher>::get_statistics(){
+  hash_table_statistics statistics;
+#ifdef HASH_TABLE_STATISTICS
+  statistics = this->statistics;
+#endif
+  statistics.rehash_time = this->rehash_time;
+  std::size_t cluster = 0;
+  for(std::size_t slot = 0; slot < 2*this->table_size; slot++){ //twice around, for the cluster that wraps around the border.
+    if(this->hash_table[slot & (this->table_size - 1)].entry != 0){
+      cluster++;
+      statistics.largest_cluster = std::max(statistics.largest_cluster, std::min(cluster, this->table_size));
+    }else{
+      cluster = 0;
+    }
+  }
+  return statistics;
+}
+
+//Returns the average and the maximum number of slots probed to find each of the stored keys,
+//which measures how well the hash function spreads the keys over the table. During an incremental
+//resize only the keys that are already in the new table are measured.
+template <class hasher>
+std::vector<double> Basic_Hash_Table<hasher>::probe_length_statistics(){
+  double total = 0.0;
+  double max = 0.0;
+  std::size_t keys = 0;
+  for(std::size_t slot = 0; slot < this->table_size; slot++){
+    if(this->hash_table[slot].entry != 0){
+      double probes = this->probe_length(this->entries[this->hash_table[slot].entry].hash, slot, this->table_size);
+      total = total + probes;
+      max = std::max(max, probes);
+      keys++;
+    }
+  }
+  if(keys == 0){
+    return std::vector<double> {0.0, 0.0};
+  }
+  return std::vector<double> {total/keys, max};
+}
+
+//Appends every key in the table, and its values for each text, to keys and key_values.
+template <class hasher>
+void Basic_Hash_Table<hasher>::copy_contents(std::vector<std::string> &keys, std::vector<std::vector<std::vector<std::size_t>>> &key_values){
+  for(std::size_t entry = 1; entry < this->entries.size(); entry++){
+    keys.push_back(this->key_string(this->entries[entry].key));
+    key_values.push_back(this->entries[entry].text_position);
+  }
+}
+
+//Builds a Frozen_Hash_Table with the keys and values in the table, which keeps a single slot per key.
+//The table is left unchanged, so it can be deleted once the frozen one is built.
+template <class hasher>
+Frozen_Hash_Table *Basic_Hash_Table<hasher>::freeze(){
+  std::vector<std::string> keys;
+  std::vector<std::vector<std::vector<std::size_t>>> key_values;
+  this->copy_contents(keys, key_values);
+  return new Frozen_Hash_Table(keys, key_values);
+}
+
+//The tables are only built with the hash functions of hash_functions.hpp.
+template class Basic_Hash_Table<Std_Hash>;
+template class Basic_Hash_Table<Wy_Hash>;
+template class Basic_Hash_Table<Fnv_Hash>;
+template class Basic_Hash_Table<Crc_Hash>;
+
 //The following are simple examples of usage.
 void example_1_hash(){
   Hash_Table *Table = new Hash_Table();
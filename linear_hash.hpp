@@ -5,19 +5,60 @@
 #include <iostream>
 #include <functional>
 #include <vector>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include "hash_functions.hpp"
 
-//A Hash_Table is, mainly, an array of hash_slots.
-struct hash_slot{
-  std::string key;
+//A key is referenced with 16 bytes. Keys of up to 15 characters are stored inline, padded with
+//zeros and with their length in the last byte, so two short keys are compared as two 64 bit words.
+//Longer keys are stored in the key arena of the table, and the reference holds their 32 bit offset
+//in the arena and their length, with long_key in the last byte.
+struct key_reference{
+  unsigned char bytes[16];
+};
+
+//Every key stored in the table has a hash_entry, which keeps the full value of the hash
+//function for the key (so it never has to be hashed again), the key and the values for each text.
+struct hash_entry{
+  std::size_t hash;
+  key_reference key;
   std::vector<std::vector<std::size_t>> text_position;
 };
 
-//Hash_Table class declaration, lists public and private methods.
-class Hash_Table{
+//A Hash_Table is, mainly, an array of hash_slots. A slot only holds the index of its entry
+//(0 for an empty slot) and the upper 32 bits of the hash of its key, which are compared
+//before looking at the entry, so an empty slot costs 8 bytes.
+struct hash_slot{
+  std::uint32_t entry;
+  std::uint32_t hash_tag;
+};
+
+class Frozen_Hash_Table;
+
+//Statistics of a Hash_Table, the histograms count the searches (successful or failed) that probed
+//each number of slots. The rehashes, and the time of each resize in milliseconds since the table was
+//created, are only counted when HASH_TABLE_STATISTICS is defined, see Hash_Table::get_statistics.
+struct hash_table_statistics{
+  std::vector<std::size_t> hit_probe_lengths;
+  std::vector<std::size_t> miss_probe_lengths;
+  std::size_t largest_cluster = 0;
+  std::size_t rehashes = 0;
+  double rehash_time = 0.0;
+  std::vector<double> resize_timestamps;
+};
+
+//Hash_Table class declaration, lists public and private methods. The hash function is a template
+//parameter (any of the functors in hash_functions.hpp), Hash_Table is the table that uses std::hash.
+template <class hasher>
+class Basic_Hash_Table{
 public:
-  Hash_Table();
+  Basic_Hash_Table();
+  Basic_Hash_Table(bool incremental_resize);
   void insert(std::string, std::size_t value, int text_index);
-  std::size_t search(std::string);
+  std::size_t search(const std::string &pattern);
+  void search_batch(const std::vector<std::string> &patterns, std::vector<bool> &out);
   void delete_data();
   std::string key_in_slot(std::size_t slot);
   bool search_report(std::string pattern, int text_index, int print);
@@ -25,22 +66,65 @@ public:
   std::size_t structure_size();
   double get_fill();
   double extra_measurement(){return this->get_fill();}
+  double get_rehash_time(){return this->rehash_time;}
   std::vector<std::size_t> occurences(std::string pattern);
+  std::vector<double> probe_length_statistics();
+  hash_table_statistics get_statistics();
+  void copy_contents(std::vector<std::string> &keys, std::vector<std::vector<std::vector<std::size_t>>> &key_values);
+  Frozen_Hash_Table *freeze();
 private:
   hash_slot *hash_table;
   std::size_t table_size;
   std::size_t stored_elements;
   std::string name = "HASH";
   std::size_t inserted;
+  double rehash_time;
+
+  //The entries are kept in insertion order, entry 0 is the one reported when a key is not found.
+  //The characters of the keys longer than 15 characters are appended to key_arena.
+  std::vector<hash_entry> entries;
+  std::vector<char> key_arena;
+  static const unsigned char long_key = 0xFF;
+
+  //While an incremental resize is in progress the previous table is kept in old_table, and the
+  //slots that have already been moved to the new table are the migrated_slots that follow migration_start.
+  bool incremental_resize = 0;
+  std::size_t slots_per_migration_step = 4;
+  hash_slot *old_table = nullptr;
+  std::size_t old_table_size = 0;
+  std::size_t migration_start = 0;
+  std::size_t migrated_slots = 0;
 
-  std::hash<std::string> hash_function;
-  std::size_t hash_value(std::string pattern);
-  std::size_t probe_free_slot(std::size_t hash_value, hash_slot *hash_table_to_probe, std::string pattern);
-  void rehash_entries(hash_slot *old_table, hash_slot *new_table);
+#ifdef HASH_TABLE_STATISTICS
+  hash_table_statistics statistics;
+  std::chrono::steady_clock::time_point creation_time;
+  void record_search(std::size_t probes, bool found);
+#endif
+
+  hasher hash_function;
+  std::size_t hash_value(const std::string &pattern);
+  key_reference make_key_reference(const std::string &pattern);
+  key_reference store_key(const std::string &pattern);
+  std::string key_string(const key_reference &key);
+  bool same_key(const hash_entry &entry, std::size_t hash, const key_reference &probe_key, const std::string &pattern);
+  std::size_t probe_free_slot(std::size_t hash, const key_reference &probe_key, const std::string &pattern);
+  void place_entry(std::uint32_t entry, hash_slot *table, std::size_t size);
+  void rehash_entries(hash_slot *new_table);
   bool first_insertion(std::size_t slot);
   void check_fill_rate();
-  std::size_t slot_size(struct hash_slot slot);
+  void start_migration();
+  void migration_step();
+  bool is_migrated(std::size_t old_slot);
+  std::size_t search_old_table(std::size_t hash, const key_reference &probe_key, const std::string &pattern);
+  hash_slot &slot_reference(std::size_t slot);
+  std::size_t probe_length(std::size_t hash, std::size_t slot, std::size_t size);
+  std::size_t entry_size(const hash_entry &entry);
   void print_positions(std::size_t slot, int text_index);
 };
 
+typedef Basic_Hash_Table<Std_Hash> Hash_Table;
+typedef Basic_Hash_Table<Wy_Hash> Wy_Hash_Table;
+typedef Basic_Hash_Table<Fnv_Hash> Fnv_Hash_Table;
+typedef Basic_Hash_Table<Crc_Hash> Crc_Hash_Table;
+
 #endif
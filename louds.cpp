@@ -0,0 +1,271 @@
+#include "louds.hpp"
+
+//Appends a bit at the end of the sequence.
+void Rank_Select_Bits::push_back(bool bit){
+  if(this->bits%64 == 0){
+    this->words.push_back(0);
+  }
+  this->words.back() = this->words.back() | ((std::uint64_t)bit << (this->bits%64));
+  this->bits++;
+}
+
+//Builds the rank blocks and the select samples, once all the bits have been pushed.
+void Rank_Select_Bits::build_index(){
+  this->block_ranks.clear();
+  this->zero_samples.clear();
+  std::size_t ones = 0;
+  std::size_t zeros = 0;
+  for(std::size_t word = 0; word < this->words.size(); word++){
+    if(word%(block_bits/64) == 0){
+      this->block_ranks.push_back(ones);
+    }
+    std::size_t word_bits = std::min((std::size_t)64, this->bits - 64*word);
+    std::size_t word_ones = __builtin_popcountll(this->words[word]);
+    std::size_t word_zeros = word_bits - word_ones;
+    //Every multiple of sample_zeros that is crossed in this word is a zero of this block.
+    while(this->zero_samples.size()*sample_zeros < zeros + word_zeros){
+      this->zero_samples.push_back(word/(block_bits/64));
+    }
+    ones = ones + word_ones;
+    zeros = zeros + word_zeros;
+  }
+  this->block_ranks.push_back(ones);
+  this->words.shrink_to_fit();
+  this->block_ranks.shrink_to_fit();
+  this->zero_samples.shrink_to_fit();
+}
+
+//Returns the number of ones before position.
+std::size_t Rank_Select_Bits::rank1(std::size_t position){
+  std::size_t block = position/block_bits;
+  std::size_t rank = this->block_ranks[block];
+  for(std::size_t word = block*(block_bits/64); word < position/64; word++){
+    rank = rank + __builtin_popcountll(this->words[word]);
+  }
+  if(position%64 != 0){
+    rank = rank + __builtin_popcountll(this->words[position/64] & ((1ULL << (position%64)) - 1));
+  }
+  return rank;
+}
+
+//Returns the position of the k-th zero (counting from 0), which must exist. The sample of k gives a block at or
+//before the one that holds it, the blocks are skipped with their ranks and then the words of the block are scanned.
+std::size_t Rank_Select_Bits::select0(std::size_t k){
+  std::size_t block = this->zero_samples[k/sample_zeros];
+  std::size_t blocks = this->block_ranks.size() - 1;
+  while(block + 1 < blocks && this->zeros_before_block(block + 1) <= k){
+    block++;
+  }
+  std::size_t remaining = k - this->zeros_before_block(block);
+  std::size_t word = block*(block_bits/64);
+  for(;; word++){
+    std::size_t word_zeros = 64 - __builtin_popcountll(this->words[word]);
+    if(remaining < word_zeros){
+      break;
+    }
+    remaining = remaining - word_zeros;
+  }
+  std::uint64_t zeros = ~this->words[word];
+  for(std::size_t i = 0; i < remaining; i++){
+    zeros = zeros & (zeros - 1);
+  }
+  return 64*word + __builtin_ctzll(zeros);
+}
+
+//Returns the number of bits taken by the sequence and its index.
+std::size_t Rank_Select_Bits::size_in_bits(){
+  return this->bits + 32*(this->block_ranks.size() + this->zero_samples.size());
+}
+
+//Releases the bits and the index.
+void Rank_Select_Bits::clear(){
+  std::vector<std::uint64_t>().swap(this->words);
+  std::vector<std::uint32_t>().swap(this->block_ranks);
+  std::vector<std::uint32_t>().swap(this->zero_samples);
+  this->bits = 0;
+}
+
+//Louds_Trie constructor. The trie starts empty, the insertions are kept in the loading table
+//until freeze is called (or the trie is built directly from the keys and values of any dictionary with build).
+Louds_Trie::Louds_Trie(){
+  this->keys = 0;
+  this->nodes = 0;
+  this->build_time = 0.0;
+}
+
+//Insertions are only possible before the trie is frozen.
+void Louds_Trie::insert(const std::string &pattern, std::size_t value, int text_index){
+  if(!this->loading_table.insert(pattern, value, text_index)){
+    std::cout << "THE TRIE IS FROZEN, " << pattern << " WAS NOT INSERTED!!!" << std::endl;
+  }
+}
+
+//Builds the trie with the keys inserted so far.
+void Louds_Trie::freeze(){
+  std::vector<std::string> keys;
+  std::vector<std::vector<std::vector<std::size_t>>> key_values;
+  if(this->loading_table.take_contents(keys, key_values)){
+    this->build(keys, key_values);
+  }
+}
+
+//Compiles the trie from the keys of a dictionary (which must be different) and their values for each text. The keys
+//are sorted and the nodes are visited in level order with a queue of ranges: the key that ends at a node comes first
+//in its range (it is the shortest) and makes the node terminal, its values being appended in the order of the terminal
+//nodes, and the rest of the range is split by the character at depth into the children. The time taken is kept
+//in build_time, in milliseconds.
+void Louds_Trie::build(std::vector<std::string> &keys, std::vector<std::vector<std::vector<std::size_t>>> &key_values){
+  auto start_time = std::chrono::steady_clock::now();
+  this->loading_table.release();
+  this->keys = keys.size();
+  std::vector<std::size_t> order(this->keys);
+  for(std::size_t i = 0; i < this->keys; i++){
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(), [&keys](std::size_t a, std::size_t b){
+    return keys[a] < keys[b];
+  });
+
+  this->louds.clear();
+  this->terminal.clear();
+  this->labels.clear();
+  this->postings.start(this->keys);
+  this->louds.push_back(1);
+  this->louds.push_back(0);
+  std::vector<louds_range> queue;
+  queue.push_back(louds_range {0, this->keys, 0});
+  for(std::size_t node = 0; node < queue.size(); node++){
+    louds_range range = queue[node];
+    std::size_t i = range.first;
+    bool is_terminal = i < range.last && keys[order[i]].size() == range.depth;
+    this->terminal.push_back(is_terminal);
+    if(is_terminal){
+      this->postings.add_key(key_values[order[i]]);
+      i++;
+    }
+    while(i < range.last){
+      std::uint8_t label = (std::uint8_t)keys[order[i]][range.depth];
+      std::size_t first = i;
+      for(i++; i < range.last && (std::uint8_t)keys[order[i]][range.depth] == label; i++){
+      }
+      this->louds.push_back(1);
+      this->labels.push_back(label);
+      queue.push_back(louds_range {first, i, range.depth + 1});
+    }
+    this->louds.push_back(0);
+  }
+  this->nodes = queue.size();
+  this->louds.build_index();
+  this->terminal.build_index();
+  this->labels.shrink_to_fit();
+  this->postings.shrink_to_fit();
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start_time;
+  this->build_time = elapsed.count();
+}
+
+//Deletes the loading table, if the trie was never frozen, and releases the sequences.
+void Louds_Trie::delete_data(){
+  this->loading_table.release();
+  this->louds.clear();
+  this->terminal.clear();
+  std::vector<std::uint8_t>().swap(this->labels);
+  this->postings.clear();
+  this->nodes = 0;
+}
+
+//Searches for the pattern, returns the rank of its node among the terminal ones or no_key if it is not in the trie.
+//For every character the block of the current node is located with two select0 (its start and its end), and the
+//character is binary searched among the labels of its children.
+std::uint32_t Louds_Trie::search(const std::string &pattern){
+  if(this->nodes == 0){
+    return no_key;
+  }
+  std::size_t node = 0;
+  for(std::size_t depth = 0; depth < pattern.size(); depth++){
+    std::size_t start = this->louds.select0(node) + 1;
+    std::size_t end = this->louds.select0(node + 1);
+    std::size_t first_child = start - (node + 1);
+    const std::uint8_t *first_label = this->labels.data() + first_child - 1;
+    const std::uint8_t *last_label = first_label + (end - start);
+    const std::uint8_t *label = std::lower_bound(first_label, last_label, (std::uint8_t)pattern[depth]);
+    if(label == last_label || *label != (std::uint8_t)pattern[depth]){
+      return no_key;
+    }
+    node = first_child + (label - first_label);
+  }
+  if(!this->terminal.get(node)){
+    return no_key;
+  }
+  return this->terminal.rank1(node);
+}
+
+//Returns the number of bits per node taken by the shape of the trie: the LOUDS sequence, the labels and the terminal bits.
+double Louds_Trie::bits_per_node(){
+  if(this->nodes == 0){
+    return 0.0;
+  }
+  return (double)(this->louds.size_in_bits() + this->terminal.size_in_bits() + 8*this->labels.size())/this->nodes;
+}
+
+//Reports whether the pattern is in the trie.
+//If print is enabled prints information pertaining to the values associated
+//to the pattern in the given text.
+bool Louds_Trie::search_report(const std::string &pattern, int text_index, int print){
+  std::uint32_t key = this->search(pattern);
+  if(key == no_key){
+    return 0;
+  }
+  if(print){
+    std::cout << pattern << " found with " << this->postings.count(key, text_index) << " occurences at positions: ";
+    this->postings.print(key, text_index);
+    std::cout << std::endl;
+  }
+  return 1;
+}
+
+//Returns the size of the structure, in bytes. Unlike the other structures it counts the bits that are used rather
+//than the capacity of the vectors: the sequences with their indexes, the labels and the postings, rounded up
+//to whole bytes. Includes the loading table if it was never frozen.
+std::size_t Louds_Trie::structure_size(){
+  std::size_t bits = 8*(sizeof(Louds_Trie) + this->name.size());
+  bits = bits + this->louds.size_in_bits() + this->terminal.size_in_bits() + 8*this->labels.size();
+  bits = bits + this->postings.size_in_bits();
+  return (bits + 7)/8 + this->loading_table.structure_size();
+}
+
+//Returns all occurences of the pattern, for each text.
+std::vector<std::size_t> Louds_Trie::occurences(const std::string &pattern){
+  std::uint32_t key = this->search(pattern);
+  if(key == no_key){
+    return std::vector<std::size_t> {0, 0};
+  }
+  return this->postings.counts(key);
+}
+
+//Simple example of usage, the trie is frozen after the insertions.
+void example_1_louds(){
+  Louds_Trie *Trie = new Louds_Trie();
+  Trie->insert("hola", 0, 0);
+  Trie->insert("ola", 1, 0);
+  Trie->insert("holograma", 2, 0);
+  Trie->insert("holografia", 3, 0);
+  Trie->insert("ho", 4, 0);
+  Trie->insert("hola", 50, 0);
+  Trie->freeze();
+
+  Trie->search_report("hola", 0, 1);
+  Trie->search_report("holograma", 0, 1);
+  Trie->search_report("holografia", 0, 1);
+  Trie->search_report("ho", 0, 1);
+  Trie->search_report("hol", 0, 1);
+  std::cout << Trie->bits_per_node() << " bits per node" << std::endl;
+
+  Trie->delete_data();
+  delete Trie;
+}
+
+//UNCOMMENT MAIN TO TEST EXAMPLES IN STANDALONE FASHION
+// int main(){
+//   example_1_louds();
+//   return 0;
+// }
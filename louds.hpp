@@ -0,0 +1,80 @@
+#ifndef __LO_H_INCLUDED__
+#define __LO_H_INCLUDED__
+
+#include <string>
+#include <iostream>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <chrono>
+#include "frozen_dictionary.hpp"
+
+//A bit sequence with rank and select support. The bits are packed in 64 bit words, block_ranks holds the number
+//of ones before every block of 512 bits, and zero_samples the block in which every 512th zero is, so that rank1
+//counts at most 8 words and select0 starts scanning close to its answer.
+class Rank_Select_Bits{
+public:
+  void push_back(bool bit);
+  void build_index();
+  bool get(std::size_t position){return (this->words[position/64] >> (position%64)) & 1;}
+  std::size_t rank1(std::size_t position);
+  std::size_t select0(std::size_t k);
+  std::size_t size_in_bits();
+  void clear();
+private:
+  std::vector<std::uint64_t> words;
+  std::size_t bits = 0;
+  std::vector<std::uint32_t> block_ranks;
+  std::vector<std::uint32_t> zero_samples;
+  static const std::size_t block_bits = 512;
+  static const std::size_t sample_zeros = 512;
+
+  std::size_t zeros_before_block(std::size_t block){return block*block_bits - this->block_ranks[block];}
+};
+
+//While a Louds_Trie is built each node is the range [first, last) of the sorted keys that share its first depth characters.
+struct louds_range{
+  std::size_t first;
+  std::size_t last;
+  std::size_t depth;
+};
+
+//A Louds_Trie is an immutable trie compiled from the keys and values of a finished dictionary, stored in a few bits
+//per node. The nodes are numbered in level order (the root is 0), and the shape of the trie is the LOUDS sequence:
+//"10" for a super root, then the degree of every node in unary (one 1 per child and a 0). The block of node i
+//starts after the i-th 0 (counting from 0), and its children are numbered consecutively from the number of ones
+//before that block. labels holds the character of the edge that leads to every node but the root, in level order,
+//so the labels of the children of a node are consecutive and sorted. terminal marks the nodes where a key ends,
+//and the values of a key are found by the rank of its node among the terminal ones, which is its key in the postings.
+class Louds_Trie{
+public:
+  static const std::uint32_t no_key = 0xFFFFFFFF;
+
+  Louds_Trie();
+  void insert(const std::string &pattern, std::size_t value, int text_index);
+  void freeze();
+  void build(std::vector<std::string> &keys, std::vector<std::vector<std::vector<std::size_t>>> &key_values);
+  std::uint32_t search(const std::string &pattern);
+  void delete_data();
+  bool search_report(const std::string &pattern, int text_index, int print);
+  std::string get_name(){return this->name;}
+  std::size_t structure_size();
+  double bits_per_node();
+  double extra_measurement(){return this->bits_per_node();}
+  double get_build_time(){return this->build_time;}
+  std::vector<std::size_t> occurences(const std::string &pattern);
+private:
+  Loading_Table loading_table;
+  std::size_t keys;
+  std::size_t nodes;
+  std::string name = "LOUDS";
+  double build_time;
+
+  Rank_Select_Bits louds;
+  Rank_Select_Bits terminal;
+  std::vector<std::uint8_t> labels;
+  Flat_Postings postings;
+};
+
+#endif
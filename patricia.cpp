@@ -1,90 +1,124 @@
 #include "patricia.hpp"
 
-//Transforms a char to its binary representation.
-//The bitset is very memory-efficient (1 bit per value)
-//but requires the size to be set at compile time, this is
-//why it is abandoned in favor of the boost::dynamic_bitset
-//which is dynamic, but uses a block or 8 bytes minimum to store
-//data, which is why it is not preferable for short sequences
-//but can be used effectively as the dictionary of the tree.
-std::bitset<8> letter_to_bitset(char letter){
-  return std::bitset<8>(letter);
-}
-
-//Transforms a string word to its binary representation.
-boost::dynamic_bitset<> word_to_bitset(std::string word){
-  int i = 0;
-  boost::dynamic_bitset<> bit_word;
-  while(i < word.size()){
-    std::bitset<8> bit_letter = letter_to_bitset(word[i]);
-    int bit_letter_slot = 0;
-    for(int j = 8*i; j < 8*(i+1); j++){
-      bit_word.push_back(bit_letter[bit_letter_slot]);
-      bit_letter_slot++;
-    }
-    i++;
+#ifdef PATRICIA_ALLOCATION_CHECK
+#include <cstdlib>
+#include <cassert>
+#include <new>
+
+//When compiled with -DPATRICIA_ALLOCATION_CHECK every call to the global operator new is counted,
+//which lets example_5_patricia check that searching the tree does not touch the heap.
+std::size_t patricia_allocations = 0;
+
+void* operator new(std::size_t size){
+  patricia_allocations++;
+  void* memory = std::malloc(size == 0 ? 1 : size);
+  if(memory == nullptr){
+    throw std::bad_alloc();
   }
-  return bit_word;
+  return memory;
+}
+
+void operator delete(void* memory) noexcept{
+  std::free(memory);
 }
+#endif
 
-//Fast and dumb function to transform a binary sequence into a number.
-int binary_number(int a0, int a1, int a2, int a3, int a4, int a5, int a6, int a7){
-  return 1*a0 + 2*a1 + 4*a2 + 8*a3 + 16*a4 + 32*a5 + 64*a6 + 128*a7;
+//Makes the binary view of a word. The view reads the characters of the word in place, so the
+//word must outlive it, and the 0 character that ends the pattern is implicit.
+bit_view word_to_bits(const std::string &word){
+  bit_view bit_pattern;
+  bit_pattern.bytes = (const unsigned char*)word.data();
+  bit_pattern.byte_size = word.size();
+  bit_pattern.size = 8*(word.size() + 1);
+  return bit_pattern;
 }
 
-//Transform a bit sequence to the character it represents.
-std::string bitset_to_word(boost::dynamic_bitset<> bit_pattern, int start_pos, int offset){
-  std::string word = "";
-  int end = start_pos + offset;
-  for(int i = start_pos; i < end; i=i+8){
-    word = word + (char)binary_number(bit_pattern[i],bit_pattern[i+1],bit_pattern[i+2],bit_pattern[i+3],bit_pattern[i+4],bit_pattern[i+5],bit_pattern[i+6],bit_pattern[i+7]);
+//Returns the bit of the pattern at a given position.
+bool bit_at(const bit_view &bit_pattern, int position){
+  std::size_t byte = position >> 3;
+  if(byte >= bit_pattern.byte_size){
+    return 0;
   }
-  return word;
+  return (bit_pattern.bytes[byte] >> (position & 7)) & 1;
 }
 
-//Checks whether a node is a leaf, by virtue of not having children.
-bool is_leaf(struct node* node){
-  return (node->left_child == nullptr && node->right_child == nullptr);
+//Returns the 64 bits of the pattern that start at a given position, as a word whose lowest bit is
+//the bit at position. The bits past the end of the word (the 0 character and beyond) are 0.
+//Since the bits of a character are in the same order as the bits of a little endian word,
+//this is a single (unaligned) load of the 9 bytes that contain the bits and a shift.
+std::uint64_t bits_at(const bit_view &bit_pattern, int position){
+  std::size_t byte = position >> 3;
+  if(byte >= bit_pattern.byte_size){
+    return 0;
+  }
+  unsigned char buffer[16] = {0};
+  std::memcpy(buffer, bit_pattern.bytes + byte, std::min(bit_pattern.byte_size - byte, (std::size_t)9));
+  std::uint64_t low;
+  std::memcpy(&low, buffer, 8);
+  int shift = position & 7;
+  if(shift == 0){
+    return low;
+  }
+  return (low >> shift) | ((std::uint64_t)buffer[8] << (64 - shift));
 }
 
-//Patricia_Tree constructor. left_offset == -1 is checked by insertion to determine
-//that the root corresponds to an empty tree.
+//Patricia_Tree constructor. The root is the first inner node, and it is the only inner node that
+//may lack a child. The tree is empty as long as there are no leaves.
 Patricia_Tree::Patricia_Tree(void){
-  this->root->left_offset = -1;
-  this->root->right_offset = 0;
-  this->root->left_child = nullptr;
-  this->root->right_child = nullptr;
-  this->root->leaf = nullptr;
-}
-
-//A leaf node contains 2 numbers that allow it to unequivocally match to a string in the dictionary: a start position
-//and an offset, this saves us from having to store the string in the node. It can be handy when the dictionary cannot
-//be stored in main memory, but in principle, since the information of each character is being stored regardless, it would
-//be better to pay the cost of a string per node (which is just 8 bytes pointer, the same as 2 ints (8 bytes according to current compiler)).
-//There is, also, the issue of branches, which inner nodes must contain to point to child nodes. This implementation stores the child pointers
-//and offset value of the branches in the node itself, this allows us to reuse the branch offset values as the start position
-//and offset of the text in the leaf nodes, which have no children, somehow compensating the additional cost of having
-//a dictionary.
-int Patricia_Tree::find_max_prefix(boost::dynamic_bitset<> bit_pattern, int start_pos, int offset){ //return the first position at which bit_pattern differs from a given entry of the dictionary
-  int j = start_pos;
-  int smallest_size = std::min(offset, (int) bit_pattern.size());
-  int pattern_slot = 0;
-  while(pattern_slot < smallest_size){
-    if (this->dictionary[j] != bit_pattern[pattern_slot]){
-      return pattern_slot;
+  inner_node root_node;
+  root_node.child[0] = no_node;
+  root_node.child[1] = no_node;
+  root_node.offset[0] = 0;
+  root_node.offset[1] = 0;
+  root_node.leaf = no_node;
+  this->inner_nodes.push_back(root_node);
+}
+
+//Returns a child of a node, or no_node if the node is a leaf or lacks that child.
+node_index Patricia_Tree::child_of(node_index node, int child_type){
+  if(node == no_node || this->is_leaf(node)){
+    return no_node;
+  }
+  return this->inner_nodes[node].child[child_type];
+}
+
+//Returns the binary view of the key stored at a leaf, which reads the characters of the key in place from the key arena.
+bit_view Patricia_Tree::leaf_key(node_index leaf){
+  const leaf_node &stored = this->leaves[leaf & ~leaf_bit];
+  bit_view key;
+  key.bytes = (const unsigned char*)this->key_arena.data() + stored.key_offset;
+  key.byte_size = stored.key_length;
+  key.size = 8*(stored.key_length + 1);
+  return key;
+}
+
+//Returns the key stored at a leaf, as a string.
+std::string Patricia_Tree::leaf_word(node_index leaf){
+  const leaf_node &stored = this->leaves[leaf & ~leaf_bit];
+  return std::string(this->key_arena.data() + stored.key_offset, stored.key_length);
+}
+
+//A leaf contains 2 numbers that allow it to unequivocally match to a key in the key arena: the position at which the
+//key starts, which is 64 bit so the arena can grow beyond what an int could address, and its length in bytes.
+//This saves us from having to store the string in the leaf.
+//Returns the first position at which bit_pattern differs from the key of the leaf, comparing 64 bits at a time.
+int Patricia_Tree::find_max_prefix(const bit_view &bit_pattern, node_index leaf){
+  bit_view key = this->leaf_key(leaf);
+  int smallest_size = std::min(key.size, bit_pattern.size);
+  for(int pattern_slot = 0; pattern_slot < smallest_size; pattern_slot = pattern_slot + 64){
+    std::uint64_t difference = bits_at(key, pattern_slot) ^ bits_at(bit_pattern, pattern_slot);
+    if(difference != 0){
+      return std::min(pattern_slot + __builtin_ctzll(difference), smallest_size);
     }
-    j++;
-    pattern_slot++;
   }
-  return pattern_slot;
+  return smallest_size;
 }
 
-//Checks if the text referenced by the leaf in the dictionary corresponds to the pattern being searched, in binary form.
-bool Patricia_Tree::is_leaf_the_pattern(struct node* leaf, boost::dynamic_bitset<> bit_pattern){
-  if (this->find_max_prefix(bit_pattern, leaf->left_offset, leaf->right_offset) == bit_pattern.size() && leaf->right_offset == bit_pattern.size()){
-    return 1;
-  }
-  return 0;
+//Checks if the key referenced by the leaf corresponds to the pattern being searched. Since the keys are
+//stored as bytes this is a length check and a memcmp.
+bool Patricia_Tree::is_leaf_the_pattern(node_index leaf, const bit_view &bit_pattern){
+  const leaf_node &stored = this->leaves[leaf & ~leaf_bit];
+  return stored.key_length == bit_pattern.byte_size && std::memcmp(this->key_arena.data() + stored.key_offset, bit_pattern.bytes, bit_pattern.byte_size) == 0;
 }
 
 //This method takes the pattern to query for in the binary and navigates the tree to find a leaf that
@@ -93,32 +127,23 @@ bool Patricia_Tree::is_leaf_the_pattern(struct node* leaf, boost::dynamic_bitset
 //reach a point that is greater than the length of the pattern (end_point) or is a leaf, we return.
 //end_point is a separate value, because this function is also used to search for the node where the
 //first different position between a new pattern and a leaf would be found, which is what we do when
-//we reinsert from a leaf.
-struct node *Patricia_Tree::node_search(boost::dynamic_bitset<> bit_pattern, int end_point, int *final_slot, struct node* parent, int *child_type){
-  struct node *current_node = this->root;
-  parent->leaf = current_node;
+//we reinsert from a leaf. The parent of the returned node is written to *parent, which is owned by
+//the caller (usually a local variable), so that no scratch node has to be allocated.
+node_index Patricia_Tree::node_search(const bit_view &bit_pattern, int end_point, int *final_slot, node_index *parent, int *child_type){
+  node_index current_node = this->root;
+  *parent = current_node;
   int current_slot = 0;
-  int reached_leaf = 0;
-  struct node* query_node = nullptr;
   while( current_slot < end_point){
-    parent->leaf = current_node;
-    if (bit_pattern[current_slot]){
-      *child_type = 1;
-      query_node = current_node->right_child;
-    }else{
-      *child_type = 0;
-      query_node = current_node->left_child;
-    }
-
-    if (query_node != nullptr){
-      current_slot = current_slot + (1-*child_type)*current_node->left_offset + (*child_type)*current_node->right_offset;
-      current_node = query_node;
-      reached_leaf = is_leaf(current_node);
-    }else{
+    *parent = current_node;
+    const inner_node &current = this->inner_nodes[current_node];
+    *child_type = bit_at(bit_pattern, current_slot);
+    node_index query_node = current.child[*child_type];
+    if (query_node == no_node){
       return current_node;
     }
-
-    if (reached_leaf){
+    current_slot = current_slot + current.offset[*child_type];
+    current_node = query_node;
+    if (this->is_leaf(current_node)){
       break;
     }
   }
@@ -127,86 +152,65 @@ struct node *Patricia_Tree::node_search(boost::dynamic_bitset<> bit_pattern, int
 }
 
 //Basic search function, which isn't used structurally but to perform queries.
-//Searches for a candidate using the previous function, up to end_point == bit_pattern.size().
-//If the candidate is a leaf, and it matches the pattern then we have a match.
-struct node* Patricia_Tree::search(std::string pattern){
-  boost::dynamic_bitset<> bit_pattern = word_to_bitset(pattern);
-  for(int i = 0; i < 8; i++){
-    bit_pattern.push_back(0);
+//Searches for a candidate using the previous function, up to end_point == bit_pattern.size.
+//If the candidate is a leaf, and it matches the pattern then we have a match, and its index is returned.
+//Otherwise returns no_node.
+//No memory is allocated: the binary view reads the pattern in place and the parent is a local index.
+node_index Patricia_Tree::search(const std::string &pattern){
+  if(this->leaves.empty()){
+    return no_node;
   }
+  bit_view bit_pattern = word_to_bits(pattern);
   int final_slot = 0;
   int child_type = 0;
-  struct node* parent = new struct node();
-  struct node* candidate = this->node_search(bit_pattern, bit_pattern.size(), &final_slot, parent, &child_type);
-  delete parent;
+  node_index parent = no_node;
+  node_index candidate = this->node_search(bit_pattern, bit_pattern.size, &final_slot, &parent, &child_type);
 
-  if (is_leaf(candidate) && this->is_leaf_the_pattern(candidate, bit_pattern)){
+  if (this->is_leaf(candidate) && this->is_leaf_the_pattern(candidate, bit_pattern)){
     return candidate;
   }
-  return nullptr;
+  return no_node;
 }
 
-//Inserts a word to the bitset dictionary, in binary form.
-int Patricia_Tree::insert_word_to_dictionary(boost::dynamic_bitset<> bit_pattern){
-  int current_size = this->dictionary.size();
-  for (int i = 0; i < bit_pattern.size(); i++){
-    this->dictionary.push_back(bit_pattern[i]);
-  }
-  return current_size;
-}
-
-//Inserts a word to the dictionary, using the previous function, and makes a new leaf node that contains the
-//necessary information to trace back to the new addition. The text_position vector that each node has
-//allows it to store the values associated with the pattern (it is an associative array after all), and the fact
-//that there are two vectors in the text_position vector means that we can keep the values of 2 separate texts
-//in a single structure, which will come in handy for the similarity testing. The text_index value is used to
-//specify the text from which the pattern comes from, and insert accordingly.
-struct node *Patricia_Tree::insert_word_and_make_leaf(boost::dynamic_bitset<> bit_pattern, std::size_t value, int text_index){
-  struct node * new_node = new struct node();
-  new_node->left_offset = this->insert_word_to_dictionary(bit_pattern);
-  new_node->right_offset = (int)bit_pattern.size();
-  new_node->right_child = nullptr;
-  new_node->left_child = nullptr;
-  new_node->text_position.push_back(std::vector<std::size_t> {});
-  new_node->text_position.push_back(std::vector<std::size_t> {});
-  new_node->text_position[text_index].push_back(value);
-  return new_node;
+//Appends the characters of a word to the key arena, and returns the position at which they start.
+std::uint64_t Patricia_Tree::insert_word_to_arena(const bit_view &bit_pattern){
+  std::uint64_t key_offset = this->key_arena.size();
+  this->key_arena.insert(this->key_arena.end(), bit_pattern.bytes, bit_pattern.bytes + bit_pattern.byte_size);
+  return key_offset;
+}
+
+//Inserts a word to the key arena, using the previous function, and makes a new leaf that contains the
+//necessary information to trace back to the new addition. Each leaf gets a key in the postings table (see
+//postings.hpp), with the same index, which stores the values associated with the pattern (it is an associative
+//array after all).
+node_index Patricia_Tree::insert_word_and_make_leaf(const bit_view &bit_pattern, std::size_t value, int text_index){
+  leaf_node new_leaf;
+  new_leaf.key_offset = this->insert_word_to_arena(bit_pattern);
+  new_leaf.key_length = bit_pattern.byte_size;
+  this->leaves.push_back(new_leaf);
+  this->postings.add_key(value, text_index);
+  return (this->leaves.size() - 1) | leaf_bit;
 }
 
 //We split a leaf because we have found its binary counterpart, so a new node
 //takes the leaf spot (child_type tells us whether the leaf was a right of left son)
 //and it branches out to the original leaf and the new node.
-struct node* Patricia_Tree::split_leaf(struct node* parent, struct node* candidate, struct node* new_pattern_node, bool branch, bool child_type){
-  struct node* new_node = new struct node();
-  new_node->left_offset = 1;
-  new_node->right_offset = 1;
-  new_node->leaf = new_pattern_node;
-
-  if (branch){
-    new_node->right_child = new_pattern_node;
-    new_node->left_child = candidate;
-  }else{
-    new_node->left_child = new_pattern_node;
-    new_node->right_child = candidate;
-  }
-
-  if(child_type){
-    parent->leaf->right_child = new_node;
-  }else{
-    parent->leaf->left_child = new_node;
-  }
-  return new_node;
+node_index Patricia_Tree::split_leaf(node_index parent, node_index candidate, node_index new_pattern_node, bool branch, bool child_type){
+  inner_node new_node;
+  new_node.offset[0] = 1;
+  new_node.offset[1] = 1;
+  new_node.leaf = new_pattern_node;
+  new_node.child[branch] = new_pattern_node;
+  new_node.child[!branch] = candidate;
+  this->inner_nodes.push_back(new_node);
+  this->inner_nodes[parent].child[child_type] = this->inner_nodes.size() - 1;
+  return this->inner_nodes.size() - 1;
 }
 
 //If the new node corresponds to the missing son of the candidate, insert it as such.
-void Patricia_Tree::insert_missing_son(struct node* candidate, struct node* new_pattern_node, bool branch){
-  if (branch){
-    candidate->right_child = new_pattern_node;
-    candidate->right_offset = 1;
-  }else{
-    candidate->left_child = new_pattern_node;
-    candidate->left_offset = 1;
-  }
+void Patricia_Tree::insert_missing_son(node_index candidate, node_index new_pattern_node, bool branch){
+  this->inner_nodes[candidate].child[branch] = new_pattern_node;
+  this->inner_nodes[candidate].offset[branch] = 1;
 }
 
 //Sometimes a new pattern differs, from those already inserted, at a point that does not have
@@ -214,22 +218,18 @@ void Patricia_Tree::insert_missing_son(struct node* candidate, struct node* new_
 //with the other child node being the node that was cut-off when the split was made.
 //This is equivalent to splitting a leaf, if we consider the cut-off node as the leaf, but
 //it requires us to update the offsets of the parent and of the new node to preserve the old
-//path jumps. Instead of using more ifs we take advantage of the deterministic nature of
-//offset arithmetics.
-void Patricia_Tree::split_arc(struct node* parent, struct node* candidate, struct node* new_pattern_node, bool branch, bool child_type, int difference_of_offset){
-  struct node* new_node = this->split_leaf(parent, candidate, new_pattern_node, branch, child_type);
-  new_node->right_offset = (branch)*(new_node->right_offset) + (1-branch)*difference_of_offset;
-  new_node->left_offset = (1-branch)*(new_node->left_offset) + (branch)*difference_of_offset;
-  parent->leaf->right_offset = parent->leaf->right_offset - (child_type)*difference_of_offset;
-  parent->leaf->left_offset = parent->leaf->left_offset - (1-child_type)*difference_of_offset;
+//path jumps.
+void Patricia_Tree::split_arc(node_index parent, node_index candidate, node_index new_pattern_node, bool branch, bool child_type, int difference_of_offset){
+  node_index new_node = this->split_leaf(parent, candidate, new_pattern_node, branch, child_type);
+  this->inner_nodes[new_node].offset[!branch] = difference_of_offset;
+  this->inner_nodes[parent].offset[child_type] = this->inner_nodes[parent].offset[child_type] - difference_of_offset;
 }
 
 //Other times the difference of a pattern lies beyond the scope of what is being considered, so we
 //extend the arc.
-void Patricia_Tree::extend_arc_and_split_leaf(struct node* parent, struct node* candidate, struct node* new_pattern_node, bool branch, bool child_type, int difference_of_offset){
+void Patricia_Tree::extend_arc_and_split_leaf(node_index parent, node_index candidate, node_index new_pattern_node, bool branch, bool child_type, int difference_of_offset){
   this->split_leaf(parent, candidate, new_pattern_node, branch, child_type);
-  parent->leaf->right_offset = parent->leaf->right_offset - child_type*difference_of_offset; //child_type == 1
-  parent->leaf->left_offset = parent->leaf->left_offset - (1-child_type)*difference_of_offset;
+  this->inner_nodes[parent].offset[child_type] = this->inner_nodes[parent].offset[child_type] - difference_of_offset;
 }
 
 //Insert calls upon this method to reinsert from a leaf, it supplies first_different_position which is the slot
@@ -249,17 +249,17 @@ void Patricia_Tree::extend_arc_and_split_leaf(struct node* parent, struct node*
 //compressed trie.
 
 //If there's a difference with the last spot jumped to: too short a jump or too long a jump, we branch accordingly.
-void Patricia_Tree::reinsert_from_leaf(struct node* leaf, boost::dynamic_bitset<> bit_pattern, std::size_t value, int text_index, int first_different_position){
+void Patricia_Tree::reinsert_from_leaf(const bit_view &bit_pattern, std::size_t value, int text_index, int first_different_position){
   int final_slot = 0;
   int child_type = 0;
-  struct node* parent = new struct node();
-  struct node* candidate = this->node_search(bit_pattern, first_different_position, &final_slot, parent, &child_type);
-  struct node* new_pattern_node = insert_word_and_make_leaf(bit_pattern, value, text_index);
-  const bool branch = bit_pattern[first_different_position];
+  node_index parent = no_node;
+  node_index candidate = this->node_search(bit_pattern, first_different_position, &final_slot, &parent, &child_type);
+  node_index new_pattern_node = this->insert_word_and_make_leaf(bit_pattern, value, text_index);
+  const bool branch = bit_at(bit_pattern, first_different_position);
   int difference_of_offset = final_slot - first_different_position;
 
   if (difference_of_offset == 0){
-    if (is_leaf(candidate)){
+    if (this->is_leaf(candidate)){
       this->split_leaf(parent, candidate, new_pattern_node, branch, child_type);
     }else{
       this->insert_missing_son(candidate, new_pattern_node, branch);
@@ -269,84 +269,63 @@ void Patricia_Tree::reinsert_from_leaf(struct node* leaf, boost::dynamic_bitset<
   }else{
     this->extend_arc_and_split_leaf(parent, candidate, new_pattern_node, branch, child_type, difference_of_offset);
   }
-  delete parent;
 }
 
 //Inserts a pattern, in binary representation, to the tree. text_index indicates whether the values
-//will be stored in the vector of the first or second text. It checks if the root corresponds to an
-//empty tree and creates it accordingly if necessary. If it isn't an empty tree it queries for a leaf
-//that might contain the pattern. If such a leaf is found then we just add the value to the corresponding
-//vector. If the leaf does not encode the pattern then we reinsert from that leaf.
+//will be stored in the vector of the first or second text. If the tree is empty the pattern becomes
+//a child of the root. Otherwise it queries for a leaf that might contain the pattern. If such a leaf
+//is found then we just add the value to the corresponding vector. If the leaf does not encode the
+//pattern then we reinsert from that leaf.
 //If the candidate is not a leaf, then we must reinsert from any leaf of that node. To speed this up
-//each node stores a direct reference to one of its leaves.
-void Patricia_Tree::insert(boost::dynamic_bitset<> bit_pattern, std::size_t value, int text_index){
-  if (this->root->left_offset == -1){
-    if(bit_pattern[0] == 1){
-      this->root->right_child = this->insert_word_and_make_leaf(bit_pattern, value, text_index);
-      this->root->left_child = nullptr;
-      this->root->leaf = this->root->right_child;
-      this->root->right_offset = 1;
-      this->root->left_offset = 0;
-    }else{
-      this->root->left_child = this->insert_word_and_make_leaf(bit_pattern, value, text_index);
-      this->root->right_child = nullptr;
-      this->root->leaf = this->root->left_child;
-      this->root->left_offset = 1;
-      this->root->right_offset = 0;
-    }
+//each inner node stores the index of one of its leaves.
+void Patricia_Tree::insert(const bit_view &bit_pattern, std::size_t value, int text_index){
+  if (this->leaves.empty()){
+    const bool branch = bit_at(bit_pattern, 0);
+    node_index new_pattern_node = this->insert_word_and_make_leaf(bit_pattern, value, text_index);
+    this->inner_nodes[this->root].child[branch] = new_pattern_node;
+    this->inner_nodes[this->root].offset[branch] = 1;
+    this->inner_nodes[this->root].leaf = new_pattern_node;
     return;
   }
   int dummy_int = 2;
-  struct node* parent = new struct node();
-  struct node* spot = this->node_search(bit_pattern, (int)bit_pattern.size(), &dummy_int, parent, &dummy_int);
-  delete parent;
-  if (is_leaf(spot)){
-    int first_different_position = this->find_max_prefix(bit_pattern, spot->left_offset, spot->right_offset);
-    if(bit_pattern.size() == first_different_position && bit_pattern.size() == spot->right_offset){
-      spot->text_position[text_index].push_back(value);
-      return;
-    }
-    this->reinsert_from_leaf(spot, bit_pattern, value, text_index, first_different_position);
+  node_index parent = no_node;
+  node_index spot = this->node_search(bit_pattern, bit_pattern.size, &dummy_int, &parent, &dummy_int);
+  if (!this->is_leaf(spot)){
+    spot = this->inner_nodes[spot].leaf;
+  }
+  int first_different_position = this->find_max_prefix(bit_pattern, spot);
+  if(bit_pattern.size == first_different_position && this->is_leaf_the_pattern(spot, bit_pattern)){
+    this->postings.add_value(spot & ~leaf_bit, value, text_index);
     return;
   }
-  int first_different_position = this->find_max_prefix(bit_pattern, spot->leaf->left_offset, spot->leaf->right_offset);
-  this->reinsert_from_leaf(spot->leaf, bit_pattern, value, text_index, first_different_position);
-  return;
+  this->reinsert_from_leaf(bit_pattern, value, text_index, first_different_position);
 }
 
-//This is the method used to insert a pattern in string form. It merely converts it to binary and calls
+//This is the method used to insert a pattern in string form. It merely takes its binary view and calls
 //the previous function.
-void Patricia_Tree::insert(std::string pattern, std::size_t value, int text_index){
-  boost::dynamic_bitset<> bit_pattern = word_to_bitset(pattern);
-  for(int p = 0; p<8; p++){
-    bit_pattern.push_back(0);
-  }
-  this->insert(bit_pattern, value, text_index);
+void Patricia_Tree::insert(const std::string &pattern, std::size_t value, int text_index){
+  this->insert(word_to_bits(pattern), value, text_index);
 }
 
-//This method deletes all the nodes of the Tree.
-void Patricia_Tree::delete_node(struct node* node){
-  if (node != nullptr){
-    this->delete_node(node->left_child);
-    this->delete_node(node->right_child);
-    delete node;
-  }
-}
-
-//Calls the previous function, made so that all 3 structures could have a common
-//name to all relevant functions for experimenting.
+//This method frees the arrays of the Tree.
 void Patricia_Tree::delete_data(){
-  this->delete_node(this->root);
+  std::vector<inner_node>().swap(this->inner_nodes);
+  std::vector<leaf_node>().swap(this->leaves);
+  this->postings.clear();
+  std::vector<char>().swap(this->key_arena);
 }
 
 //Finds the depth of the tree of root node.
-int Patricia_Tree::find_depth(struct node* node){
-  if (node != nullptr){
-    int left = this->find_depth(node->left_child);
-    int right = this->find_depth(node->right_child);
-    return 1 + std::max(left,right);
+int Patricia_Tree::find_depth(node_index node){
+  if (node == no_node || this->inner_nodes.empty()){
+    return 0;
   }
-  return 0;
+  if (this->is_leaf(node)){
+    return 1;
+  }
+  int left = this->find_depth(this->inner_nodes[node].child[0]);
+  int right = this->find_depth(this->inner_nodes[node].child[1]);
+  return 1 + std::max(left,right);
 }
 
 //The following functions are used to make a printable representation of the tree
@@ -355,11 +334,11 @@ int Patricia_Tree::find_depth(struct node* node){
 std::vector<std::vector<cell_display>> Patricia_Tree::get_row_display(int type) {
     // start off by traversing the tree to
     // build a vector of vectors of Node pointers
-    std::vector<struct node*> traversal_stack;
-    std::vector< std::vector<struct node*> > rows;
-    if(!root) return std::vector<std::vector<cell_display>>();
+    std::vector<node_index> traversal_stack;
+    std::vector< std::vector<node_index> > rows;
+    if(this->inner_nodes.empty()) return std::vector<std::vector<cell_display>>();
 
-    struct node *p = this->root;
+    node_index p = this->root;
     const int max_depth = this->find_depth(p);
     rows.resize(max_depth);
     int depth = 0;
@@ -377,7 +356,7 @@ std::vector<std::vector<cell_display>> Patricia_Tree::get_row_display(int type)
         if(traversal_stack.size() == depth) {
             rows[depth].push_back(p);
             traversal_stack.push_back(p);
-            if(p) p = p->left_child;
+            p = this->child_of(p, 0);
             ++depth;
             continue;
         }
@@ -385,7 +364,7 @@ std::vector<std::vector<cell_display>> Patricia_Tree::get_row_display(int type)
         // Odd child count? Go to right child.
         if(rows[depth+1].size() % 2) {
             p = traversal_stack.back();
-            if(p) p = p->right_child;
+            p = this->child_of(p, 1);
             ++depth;
             continue;
         }
@@ -410,17 +389,21 @@ std::vector<std::vector<cell_display>> Patricia_Tree::get_row_display(int type)
     // std::stringstream ss;
     for(const auto& row : rows) {
         rows_disp.emplace_back();
-        for(struct node* pn : row) {
-            if(pn) {
+        for(node_index pn : row) {
+            if(pn != no_node) {
                 // ss << pn->offset;
                 std::string text;
                 if (type == 0){ //print node info
-                  text = "(" + std::to_string(pn->left_offset) + ", " + std::to_string(pn->right_offset) + ", " + std::to_string(is_leaf(pn)) + ")";
+                  if(this->is_leaf(pn)){
+                    text = "(" + std::to_string(this->leaves[pn & ~leaf_bit].key_offset) + ", " + std::to_string(this->leaves[pn & ~leaf_bit].key_length) + ", 1)";
+                  }else{
+                    text = "(" + std::to_string(this->inner_nodes[pn].offset[0]) + ", " + std::to_string(this->inner_nodes[pn].offset[1]) + ", 0)";
+                  }
                 }else{ //print node pattern
-                  if(is_leaf(pn)){
-                  text = "(" + bitset_to_word(this->dictionary, pn->left_offset, pn->right_offset) + ")";
+                  if(this->is_leaf(pn)){
+                  text = "(" + this->leaf_word(pn) + ")";
                   }else{
-                    text = "(INNER, " + std::to_string(pn->left_offset) + ", " + std::to_string(pn->right_offset) +  ")";
+                    text = "(INNER, " + std::to_string(this->inner_nodes[pn].offset[0]) + ", " + std::to_string(this->inner_nodes[pn].offset[1]) +  ")";
                   }
                 }
                 rows_disp.back().push_back(cell_display(text));
@@ -577,21 +560,14 @@ void Patricia_Tree::print_tree(int type){
     }
   }
 
-//prints the values associated with the key that the node represents.
-void Patricia_Tree::print_positions(struct node* node, int text_index){
-  for(int i = 0; i < node->text_position[text_index].size(); i++){
-    std::cout << node->text_position[text_index][i] << ", ";
-  }
-}
-
 //Searches for a pattern and reports whether it finds it or not. If print is enabled, it
 //also prints the positions for a given text.
-bool Patricia_Tree::search_report(std::string pattern, int text_index, int print){
-  struct node* candidate = this->search(pattern);
-  if (candidate != nullptr){
+bool Patricia_Tree::search_report(const std::string &pattern, int text_index, int print){
+  node_index candidate = this->search(pattern);
+  if (candidate != no_node){
     if(print){
-      std::cout << pattern << " found with "<< candidate->text_position[text_index].size() <<" occurences at positions: ";
-      this->print_positions(candidate, text_index);
+      std::cout << pattern << " found with "<< this->postings.count(candidate & ~leaf_bit, text_index) <<" occurences at positions: ";
+      this->postings.print(candidate & ~leaf_bit, text_index);
       std::cout << std::endl;
     }
     return 1;
@@ -599,33 +575,23 @@ bool Patricia_Tree::search_report(std::string pattern, int text_index, int print
   return 0;
 }
 
-//Computes the total size used to encode occurences (values) associated with a key.
+//Returns the total size of the tree, in bytes: the node arrays, the key arena and the postings table.
 //Note that we use the capacity function of the vector class, which tells us the allocated space
 //for the vector (in terms of elements), which might differ from the number of stored elements.
-std::size_t Patricia_Tree::pattern_occurences_cost(std::vector<std::vector<std::size_t>> occurences){
-  if(occurences.size() > 0){
-    return sizeof(std::size_t)*(occurences[0].capacity() + occurences[1].capacity());
-  }
-  return 0;
-}
-
-//Computes the size of the subtree rooted at node.
-std::size_t Patricia_Tree::node_cost(struct node* node){
-  if(node != nullptr){
-    return node->text_position.capacity()*sizeof(std::vector<std::size_t>) + sizeof(struct node) + this->node_cost(node->left_child) + this->node_cost(node->right_child) + this->pattern_occurences_cost(node->text_position);
-  }
-  return 0;
-}
-
-//Returns the total size of the tree, in bytes.
 std::size_t Patricia_Tree::structure_size(){
-  return sizeof(Patricia_Tree) + this->dictionary.size()/8 + this->node_cost(this->root) + this->name.capacity()*sizeof(char);
+  std::size_t size = sizeof(Patricia_Tree) + this->name.capacity()*sizeof(char) + this->key_arena.capacity()*sizeof(char);
+  size = size + this->inner_nodes.capacity()*sizeof(inner_node) + this->leaves.capacity()*sizeof(leaf_node);
+  size = size + this->postings.structure_size();
+  return size;
 }
 
 //Returns all occurences of the pattern, for each text.
-std::vector<std::size_t> Patricia_Tree::occurences(std::string pattern){
-  struct node* candidate = this->search(pattern);
-  return std::vector<std::size_t> {candidate->text_position[0].size(), candidate->text_position[1].size()};
+std::vector<std::size_t> Patricia_Tree::occurences(const std::string &pattern){
+  node_index candidate = this->search(pattern);
+  if(candidate == no_node){
+    return std::vector<std::size_t> {0, 0};
+  }
+  return std::vector<std::size_t> {this->postings.count(candidate & ~leaf_bit, 0), this->postings.count(candidate & ~leaf_bit, 1)};
 }
 
 //The following are small, plainly laid out, examples of the execution of the tree.
@@ -743,6 +709,39 @@ void example_4_patricia(){
   delete Tree;
 }
 
+#ifdef PATRICIA_ALLOCATION_CHECK
+//Checks that searching for stored and missing patterns makes no allocations, both with search and with
+//search_report (the lookup used by the experiments, which only allocates when it prints), and aborts otherwise.
+//Inserting a new pattern allocates its leaf, the inner node that branches to it and the vectors of values.
+void example_5_patricia(){
+  Patricia_Tree *Tree = new Patricia_Tree();
+  std::vector<std::string> words {"hola", "ola", "holograma", "holografia", "ho", "a somewhat longer pattern than the rest"};
+  for(std::size_t i = 0; i < words.size(); i++){
+    Tree->insert(words[i], i, 0);
+  }
+  words.push_back("hol");
+  words.push_back("holografias");
+  words.push_back("b");
+  std::size_t found = 0;
+  std::size_t reported = 0;
+  std::size_t allocations = patricia_allocations;
+  for(std::size_t i = 0; i < words.size(); i++){
+    found = found + (Tree->search(words[i]) != Patricia_Tree::no_node);
+    reported = reported + Tree->search_report(words[i], 0, 0);
+  }
+  allocations = patricia_allocations - allocations;
+  std::cout << found << " of " << words.size() << " patterns found (" << reported << " reported) with " << allocations << " allocations" << std::endl;
+  if(allocations != 0){
+    std::cout << "SEARCHING THE PATRICIA TREE ALLOCATED MEMORY!!!" << std::endl;
+  }
+  assert(allocations == 0);
+  assert(found == 6 && reported == 6);
+
+  Tree->delete_data();
+  delete Tree;
+}
+#endif
+
 //UNCOMMENT MAIN TO TEST EXAMPLES IN STANDALONE FASHION
 // int main(){
 // example_4();
@@ -1,11 +1,13 @@
 #ifndef __P_H_INCLUDED__
 #define __P_H_INCLUDED__
 
-#include <boost/dynamic_bitset.hpp>
-#include <bitset>
 #include <string>
 #include <iostream>
 #include <algorithm>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include "postings.hpp"
 
 //This struct is used to print the tree
 struct cell_display {
@@ -15,64 +17,91 @@ struct cell_display {
     cell_display(std::string valstr) : valstr(valstr), present(true) {}
 };
 
-//This is the core of the patricia tree, its node.
-//Has pointers to both childs (since it's a binary tree) and a third leaf pointer
-//with which an inner node can point to any of its leaves, for quick access.
-//left_offset and right_offset serve as jump values for the branches. Once a bit
-//of the pattern has been inspected in the node we jump left_offset or right_offset
-//units in the pattern and advance to the corresponding branch.
-//text_position contains the values associated with the key for each text.
-//In the case of leaf nodes, which don't branch, left_offset is used as start_position
-//and right_offset is used as offset, to encode a pattern in the dictionary.
-struct node{
-  struct node *left_child;
-  int left_offset;
-  struct node *right_child;
-  int right_offset;
-  struct node *leaf;
-  std::vector<std::vector<std::size_t>> text_position;
+//The nodes of the patricia tree live in two arrays, one of inner nodes and one of leaves, and are
+//referred to by 32 bit indices (node_index). The highest bit of an index tells whether it refers to
+//a leaf (leaf_bit set) or to an inner node, and no_node is used for a missing child.
+typedef std::uint32_t node_index;
+
+//An inner node has both childs (since it's a binary tree) and a third leaf index with which it can
+//point to any of its leaves, for quick access. offset holds the jump values for the branches: once a bit
+//of the pattern has been inspected in the node we jump offset[bit] units in the pattern and advance
+//to child[bit]. Inner nodes hold no values, so they take 20 bytes.
+struct inner_node{
+  node_index child[2];
+  int offset[2];
+  node_index leaf;
+};
+
+//A leaf encodes a pattern in the key arena, with the position at which it starts and its length in
+//bytes. The values associated with the key of leaf i, for both texts, are kept in a separate table
+//(postings[i]), so that inner nodes pay nothing for them.
+struct leaf_node{
+  std::uint64_t key_offset;
+  std::uint32_t key_length;
+};
+
+//A pattern in binary form, read straight from the characters of the word without copying them: bit i of
+//the pattern is bit i%8 of character i/8, and the word is followed by a 0 character (8 zero bits) so that
+//no pattern is a prefix of another. size is the number of bits, including those of the 0 character.
+struct bit_view{
+  const unsigned char *bytes;
+  std::size_t byte_size;
+  int size;
 };
 
 //The Patricia_Tree class declaration. Details which methods and arguments
 //are public and private.
 class Patricia_Tree{
 public:
+  static const node_index no_node = 0xFFFFFFFF;
+  static const node_index leaf_bit = 0x80000000;
+
   Patricia_Tree();
-  void insert(std::string pattern, std::size_t value, int text_index);
-  void insert(boost::dynamic_bitset<> bit_pattern, std::size_t value, int text_index);
+  void insert(const std::string &pattern, std::size_t value, int text_index);
   void delete_data();
-  struct node* search(std::string pattern);
+  node_index search(const std::string &pattern);
   void print_tree(int type);
-  bool search_report(std::string pattern, int text_index, int print);
+  bool search_report(const std::string &pattern, int text_index, int print);
   std::string get_name(){return this->name;}
   std::size_t structure_size();
   double extra_measurement(){return this->find_depth(this->root);}
-  std::vector<std::size_t> occurences(std::string pattern);
+  std::vector<std::size_t> occurences(const std::string &pattern);
 private:
-  struct node *root = new struct node();
-  boost::dynamic_bitset<> dictionary;
+  node_index root = 0;
+  std::vector<inner_node> inner_nodes;
+  std::vector<leaf_node> leaves;
+  Postings_Table postings;
+  //The characters of the keys are appended to key_arena.
+  std::vector<char> key_arena;
   std::string name = "PATR";
 
-  int find_max_prefix(boost::dynamic_bitset<> bit_pattern, int start_pos, int offset);
-  bool is_leaf_the_pattern(struct node* leaf, boost::dynamic_bitset<> bit_pattern);
-  struct node *node_search(boost::dynamic_bitset<> bit_pattern, int end_point, int *final_slot, struct node* parent, int *child_type);
-  int insert_word_to_dictionary(boost::dynamic_bitset<> bit_pattern);
-  struct node *insert_word_and_make_leaf(boost::dynamic_bitset<> bit_pattern, std::size_t value, int text_index);
-  struct node *split_leaf(struct node* parent, struct node* candidate, struct node* new_pattern_node, bool branch, bool child_type);
-  void insert_missing_son(struct node* candidate, struct node* new_pattern_node, bool branch);
-  void split_arc(struct node* parent, struct node* candidate, struct node* new_pattern_node, bool branch, bool child_type, int difference_of_offset);
-  void extend_arc_and_split_leaf(struct node* parent, struct node* candidate, struct node* new_pattern_node, bool branch, bool child_type, int difference_of_offset);
-  void reinsert_from_leaf(struct node* leaf, boost::dynamic_bitset<> bit_pattern, std::size_t value, int text_index, int first_different_position);
-  void delete_node(struct node* node);
-  int find_depth(struct node* node);
+  bool is_leaf(node_index node){return (node & leaf_bit) != 0;}
+  node_index child_of(node_index node, int child_type);
+  bit_view leaf_key(node_index leaf);
+  std::string leaf_word(node_index leaf);
+  int find_max_prefix(const bit_view &bit_pattern, node_index leaf);
+  bool is_leaf_the_pattern(node_index leaf, const bit_view &bit_pattern);
+  node_index node_search(const bit_view &bit_pattern, int end_point, int *final_slot, node_index *parent, int *child_type);
+  std::uint64_t insert_word_to_arena(const bit_view &bit_pattern);
+  node_index insert_word_and_make_leaf(const bit_view &bit_pattern, std::size_t value, int text_index);
+  node_index split_leaf(node_index parent, node_index candidate, node_index new_pattern_node, bool branch, bool child_type);
+  void insert_missing_son(node_index candidate, node_index new_pattern_node, bool branch);
+  void split_arc(node_index parent, node_index candidate, node_index new_pattern_node, bool branch, bool child_type, int difference_of_offset);
+  void extend_arc_and_split_leaf(node_index parent, node_index candidate, node_index new_pattern_node, bool branch, bool child_type, int difference_of_offset);
+  void insert(const bit_view &bit_pattern, std::size_t value, int text_index);
+  void reinsert_from_leaf(const bit_view &bit_pattern, std::size_t value, int text_index, int first_different_position);
+  int find_depth(node_index node);
   std::vector<std::vector<cell_display>> get_row_display(int type);
   std::vector<std::string> row_formatter(const std::vector<std::vector<cell_display>>& rows_disp);
   void trim_rows_left(std::vector<std::string>& rows);
-  void print_positions(struct node* node, int text_index);
-  std::size_t pattern_occurences_cost(std::vector<std::vector<std::size_t>> occurences);
-  std::size_t node_cost(struct node* node);
 };
 
-boost::dynamic_bitset<> word_to_bitset(std::string word);
+bit_view word_to_bits(const std::string &word);
+bool bit_at(const bit_view &bit_pattern, int position);
+std::uint64_t bits_at(const bit_view &bit_pattern, int position);
+
+#ifdef PATRICIA_ALLOCATION_CHECK
+void example_5_patricia();
+#endif
 
 #endif
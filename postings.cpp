@@ -0,0 +1,47 @@
+#include "postings.hpp"
+
+//Adds a key without values, returns its index.
+std::uint32_t Postings_Table::add_key(){
+  this->values.push_back(std::vector<std::size_t> {});
+  this->counts.push_back(0);
+  this->counts.push_back(0);
+  return this->values.size() - 1;
+}
+
+//Adds a key with its first value, returns its index.
+std::uint32_t Postings_Table::add_key(std::size_t value, int text_index){
+  std::uint32_t key = this->add_key();
+  this->add_value(key, value, text_index);
+  return key;
+}
+
+//Adds a value to a key, for a given text.
+void Postings_Table::add_value(std::uint32_t key, std::size_t value, int text_index){
+  this->values[key].push_back((value << 1) | text_index);
+  this->counts[2*key + text_index]++;
+}
+
+//Prints the values of a key, for a given text.
+void Postings_Table::print(std::uint32_t key, int text_index){
+  const std::vector<std::size_t> &key_values = this->values[key];
+  for(std::size_t i = 0; i < key_values.size(); i++){
+    if((key_values[i] & 1) == (std::size_t)text_index){
+      std::cout << (key_values[i] >> 1) << ", ";
+    }
+  }
+}
+
+//Returns the size of the table in bytes, using the capacity of the vectors.
+std::size_t Postings_Table::structure_size(){
+  std::size_t size = this->values.capacity()*sizeof(std::vector<std::size_t>) + this->counts.capacity()*sizeof(std::uint32_t);
+  for(std::size_t i = 0; i < this->values.size(); i++){
+    size = size + this->values[i].capacity()*sizeof(std::size_t);
+  }
+  return size;
+}
+
+//Releases every key and its values.
+void Postings_Table::clear(){
+  std::vector<std::vector<std::size_t>>().swap(this->values);
+  std::vector<std::uint32_t>().swap(this->counts);
+}
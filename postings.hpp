@@ -0,0 +1,28 @@
+#ifndef __PO_H_INCLUDED__
+#define __PO_H_INCLUDED__
+
+#include <iostream>
+#include <vector>
+#include <cstdint>
+
+//A Postings_Table keeps the values of the keys of a tree, where every key is referred to by the index it got
+//when it was added. Every value is stored shifted one bit to the left, with the text_index of the text it comes
+//from in the lowest bit, so the values of 2 separate texts are kept in a single vector per key, which comes in
+//handy for the similarity testing without paying for a second vector. The number of values of every key for each
+//text is kept on the side, so counting the occurences of a key does not scan its values.
+class Postings_Table{
+public:
+  std::uint32_t add_key();
+  std::uint32_t add_key(std::size_t value, int text_index);
+  void add_value(std::uint32_t key, std::size_t value, int text_index);
+  std::size_t count(std::uint32_t key, int text_index){return this->counts[2*key + text_index];}
+  void print(std::uint32_t key, int text_index);
+  std::size_t size(){return this->values.size();}
+  std::size_t structure_size();
+  void clear();
+private:
+  std::vector<std::vector<std::size_t>> values;
+  std::vector<std::uint32_t> counts;
+};
+
+#endif
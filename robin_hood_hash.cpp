@@ -0,0 +1,197 @@
+#include "robin_hood_hash.hpp"
+
+//Robin_Hood_Table constructor. It starts with 100 slots and, just like the Hash_Table, doubles
+//whenever the load factor would grow beyond max_load_factor. Robin Hood insertion keeps the
+//probe distances of all keys close to each other, so the table can be filled up to 0.8 by default
+//instead of the 0.4 of the Hash_Table, which needs half the slots for the same number of keys.
+Robin_Hood_Table::Robin_Hood_Table() : Robin_Hood_Table(0.8){
+}
+
+Robin_Hood_Table::Robin_Hood_Table(double max_load_factor){
+  this->max_load_factor = max_load_factor;
+  this->table_size = 100;
+  this->stored_elements = 0;
+  this->hash_table = new robin_slot[this->table_size + 1];
+  this->hash_table[this->table_size].key = "VALUE NOT FOUND";
+  this->hash_table[this->table_size].text_position.push_back(std::vector<std::size_t> {});
+  this->hash_table[this->table_size].text_position.push_back(std::vector<std::size_t> {});
+}
+
+//Returns the load factor of the table.
+double Robin_Hood_Table::get_fill(){
+  return this->stored_elements/(double)this->table_size;
+}
+
+//Places an entry (which must not be in the table) starting from its starting slot. Whenever the
+//entry being placed is further from its starting slot than the entry in the current slot, the
+//two are swapped and we carry on placing the displaced entry, which takes from the rich (entries
+//close to their starting slot) to give to the poor.
+void Robin_Hood_Table::place_entry(robin_slot &entry, robin_slot *table){
+  std::size_t slot = entry.hash%this->table_size;
+  entry.probe_distance = 0;
+  while(table[slot].probe_distance != -1){
+    if(table[slot].probe_distance < entry.probe_distance){
+      std::swap(table[slot], entry);
+    }
+    slot = (slot+1)%this->table_size;
+    entry.probe_distance++;
+  }
+  std::swap(table[slot], entry);
+}
+
+//This function checks the load factor, and if the threshold has been surpassed then
+//it doubles the table and places the entries again, moving them with their stored hash.
+void Robin_Hood_Table::check_fill_rate(){
+  if(((this->stored_elements + 1)/(double)this->table_size) > this->max_load_factor){
+    robin_slot *old_table = this->hash_table;
+    std::size_t original_size = this->table_size;
+    this->table_size = 2*this->table_size;
+    this->hash_table = new robin_slot[this->table_size + 1];
+    this->hash_table[this->table_size].key = "VALUE NOT FOUND";
+    this->hash_table[this->table_size].text_position.push_back(std::vector<std::size_t> {});
+    this->hash_table[this->table_size].text_position.push_back(std::vector<std::size_t> {});
+    for(std::size_t i = 0; i < original_size; i++){
+      if(old_table[i].probe_distance != -1){
+        this->place_entry(old_table[i], this->hash_table);
+      }
+    }
+    delete[] old_table;
+  }
+}
+
+//Insertion function. If the pattern is already in the table the value is added to its slot,
+//otherwise a new entry is made with the vectors to store the values per text, and placed.
+void Robin_Hood_Table::insert(std::string pattern, std::size_t value, int text_index){
+  std::size_t slot = this->search(pattern);
+  if(slot != this->table_size){
+    this->hash_table[slot].text_position[text_index].push_back(value);
+    return;
+  }
+  this->check_fill_rate();
+  robin_slot entry;
+  entry.hash = this->hash_function(pattern);
+  entry.key = pattern;
+  entry.text_position.push_back(std::vector<std::size_t> {});
+  entry.text_position.push_back(std::vector<std::size_t> {});
+  entry.text_position[text_index].push_back(value);
+  this->place_entry(entry, this->hash_table);
+  this->stored_elements++;
+}
+
+//Erases the pattern, and all its values, from the table. Instead of leaving a tombstone the
+//following entries are shifted back one slot, until an empty slot or an entry that is already
+//in its starting slot is found, so the table looks as if the pattern had never been inserted.
+bool Robin_Hood_Table::erase(const std::string &pattern){
+  std::size_t slot = this->search(pattern);
+  if(slot == this->table_size){
+    return 0;
+  }
+  std::size_t next = (slot+1)%this->table_size;
+  while(this->hash_table[next].probe_distance > 0){
+    std::swap(this->hash_table[slot], this->hash_table[next]);
+    this->hash_table[slot].probe_distance--;
+    slot = next;
+    next = (next+1)%this->table_size;
+  }
+  this->hash_table[slot] = robin_slot();
+  this->stored_elements--;
+  return 1;
+}
+
+//Deletes the hash_table array.
+void Robin_Hood_Table::delete_data(){
+  delete[] this->hash_table;
+}
+
+//Searches for the pattern starting at its starting slot. Since the entries are ordered by their
+//probe distance, the search for a missing key stops as soon as it reaches an entry that is closer
+//to its own starting slot than the pattern would be, without having to reach an empty slot.
+std::size_t Robin_Hood_Table::search(const std::string &pattern){
+  std::size_t hash = this->hash_function(pattern);
+  std::size_t slot = hash%this->table_size;
+  int distance = 0;
+  while(distance <= this->hash_table[slot].probe_distance){
+    if(this->hash_table[slot].hash == hash && this->hash_table[slot].key == pattern){
+      return slot;
+    }
+    slot = (slot+1)%this->table_size;
+    distance++;
+  }
+  return this->table_size;
+}
+
+//Returns the key stored at a specified slot.
+std::string Robin_Hood_Table::key_in_slot(std::size_t slot){
+  return this->hash_table[slot].key;
+}
+
+//Prints all the values stored at a given slot, for a given text.
+void Robin_Hood_Table::print_positions(std::size_t slot, int text_index){
+  for(int i = 0; i < this->hash_table[slot].text_position[text_index].size(); i++){
+    std::cout << this->hash_table[slot].text_position[text_index][i] << ", ";
+  }
+}
+
+//Reports whether the pattern is in the table.
+//If print is enabled prints information pertaining to the values associated
+//to the pattern in the given text.
+bool Robin_Hood_Table::search_report(std::string pattern, int text_index, int print){
+  std::size_t slot = this->search(pattern);
+  if(print){
+    std::cout << pattern << " found in slot " << slot << " with " << this->hash_table[slot].text_position[text_index].size() << " occurences: ";
+    this->print_positions(slot, text_index);
+    std::cout << std::endl;
+  }
+  return slot != this->table_size;
+}
+
+//Computes the total size used by a slot.
+std::size_t Robin_Hood_Table::slot_size(const robin_slot &slot){
+  std::size_t size = sizeof(robin_slot);
+  if(slot.text_position.size() > 0){
+    size = size + slot.key.capacity();
+    size = size + slot.text_position.capacity()*sizeof(std::vector<std::size_t>);
+    size = size + (slot.text_position[0].capacity() + slot.text_position[1].capacity())*sizeof(std::size_t);
+  }
+  return size;
+}
+
+//Returns the size of the structure, in bytes.
+std::size_t Robin_Hood_Table::structure_size(){
+  std::size_t size = sizeof(Robin_Hood_Table) + this->name.capacity()*sizeof(char);
+  for(std::size_t i = 0; i <= this->table_size; i++){
+    size = size + this->slot_size(this->hash_table[i]);
+  }
+  return size;
+}
+
+//Returns all occurences of the pattern, for each text.
+std::vector<std::size_t> Robin_Hood_Table::occurences(std::string pattern){
+  std::size_t slot = this->search(pattern);
+  return std::vector<std::size_t> {this->hash_table[slot].text_position[0].size(), this->hash_table[slot].text_position[1].size()};
+}
+
+//Simple example of usage, including the removal of keys.
+void example_1_robin_hood(){
+  Robin_Hood_Table *Table = new Robin_Hood_Table();
+  Table->insert("SOME", 0, 0);
+  Table->insert("ABACUS", 4, 0);
+  Table->insert("SOMETHING", 16, 0);
+  Table->insert("B", 50, 0);
+  Table->insert("SOME", 40, 0);
+  Table->erase("ABACUS");
+
+  Table->search_report("SOME",0, 1);
+  Table->search_report("ABACUS",0, 1);
+  Table->search_report("SOMETHING",0, 1);
+  Table->search_report("B",0, 1);
+
+  Table->delete_data();
+  delete Table;
+}
+
+//UNCOMMENT MAIN TO TEST EXAMPLES IN STANDALONE FASHION
+// int main(){
+//   example_1_robin_hood();
+//   return 0;
+// }
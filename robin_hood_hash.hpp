@@ -0,0 +1,48 @@
+#ifndef __R_H_INCLUDED__
+#define __R_H_INCLUDED__
+
+#include <string>
+#include <iostream>
+#include <functional>
+#include <vector>
+
+//A Robin_Hood_Table slot holds the same information as a hash_slot, plus the distance
+//between the slot and the starting slot of its key (probe_distance), which is -1 for empty slots.
+struct robin_slot{
+  std::size_t hash;
+  int probe_distance = -1;
+  std::string key;
+  std::vector<std::vector<std::size_t>> text_position;
+};
+
+//Robin_Hood_Table class declaration. It has the same interface as the Hash_Table, plus erase.
+class Robin_Hood_Table{
+public:
+  Robin_Hood_Table();
+  Robin_Hood_Table(double max_load_factor);
+  void insert(std::string pattern, std::size_t value, int text_index);
+  bool erase(const std::string &pattern);
+  std::size_t search(const std::string &pattern);
+  void delete_data();
+  std::string key_in_slot(std::size_t slot);
+  bool search_report(std::string pattern, int text_index, int print);
+  std::string get_name(){return this->name;}
+  std::size_t structure_size();
+  double get_fill();
+  double extra_measurement(){return this->get_fill();}
+  std::vector<std::size_t> occurences(std::string pattern);
+private:
+  robin_slot *hash_table;
+  std::size_t table_size;
+  std::size_t stored_elements;
+  double max_load_factor;
+  std::string name = "ROBIN";
+
+  std::hash<std::string> hash_function;
+  void place_entry(robin_slot &entry, robin_slot *table);
+  void check_fill_rate();
+  std::size_t slot_size(const robin_slot &slot);
+  void print_positions(std::size_t slot, int text_index);
+};
+
+#endif
@@ -0,0 +1,228 @@
+#include "swiss_hash.hpp"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+//Swiss_Table constructor. The table is split in groups of group_width slots, and the number
+//of groups is kept a power of 2 so the group of a hash can be taken with a mask. We start with
+//8 groups (128 slots) and double the table every time the load factor grows beyond 7/8, which
+//the fingerprints allow us to afford because most of the probed slots are discarded without
+//touching their key.
+Swiss_Table::Swiss_Table(){
+  this->stored_elements = 0;
+  this->allocate_table(128);
+}
+
+//Creates the slot and control arrays for a table of the given size. Just like the Hash_Table
+//we keep an additional slot at the end, which is the one reported when a key is not found.
+void Swiss_Table::allocate_table(std::size_t size){
+  this->table_size = size;
+  this->slots = new swiss_slot[size + 1];
+  this->slots[size].key = "VALUE NOT FOUND";
+  this->slots[size].text_position.push_back(std::vector<std::size_t> {});
+  this->slots[size].text_position.push_back(std::vector<std::size_t> {});
+  this->control = new std::int8_t[size];
+  for(std::size_t i = 0; i < size; i++){
+    this->control[i] = empty_control;
+  }
+}
+
+//Returns the load factor of the table.
+double Swiss_Table::get_fill(){
+  return this->stored_elements/(double)this->table_size;
+}
+
+//Compares the 16 control bytes of a group against a fingerprint at once and returns a mask
+//with a bit set for every slot of the group whose fingerprint matches.
+std::uint32_t Swiss_Table::match_group(const std::int8_t *group, std::int8_t fingerprint){
+#ifdef __SSE2__
+  __m128i control_bytes = _mm_loadu_si128((const __m128i*)group);
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(fingerprint), control_bytes));
+#else
+  std::uint32_t mask = 0;
+  for(std::size_t i = 0; i < group_width; i++){
+    mask = mask | ((std::uint32_t)(group[i] == fingerprint) << i);
+  }
+  return mask;
+#endif
+}
+
+//Returns a mask with a bit set for every empty slot of the group. Since fingerprints only use
+//the 7 lowest bits, the empty slots are exactly those whose control byte has its sign bit set.
+std::uint32_t Swiss_Table::empty_in_group(const std::int8_t *group){
+#ifdef __SSE2__
+  return _mm_movemask_epi8(_mm_loadu_si128((const __m128i*)group));
+#else
+  std::uint32_t mask = 0;
+  for(std::size_t i = 0; i < group_width; i++){
+    mask = mask | ((std::uint32_t)(group[i] < 0) << i);
+  }
+  return mask;
+#endif
+}
+
+//Probes the table group by group, starting at the group given by the high bits of the hash and
+//jumping 1, 2, 3... groups after each miss (which visits every group, since the number of groups is
+//a power of 2). In each group only the slots whose fingerprint matches get their key compared.
+//If the pattern is found, found is set and its slot is returned, otherwise the first empty slot
+//of the first group that has one is returned (the pattern cannot be further along the sequence).
+std::size_t Swiss_Table::find_or_free_slot(const std::string &pattern, std::size_t hash, bool *found){
+  std::size_t groups = this->table_size/group_width;
+  std::size_t group = (hash >> 7) & (groups - 1);
+  std::int8_t fingerprint = (std::int8_t)(hash & 0x7F);
+  for(std::size_t jump = 1; jump <= groups; jump++){
+    const std::int8_t *group_control = this->control + group*group_width;
+    std::uint32_t candidates = this->match_group(group_control, fingerprint);
+    while(candidates != 0){
+      std::size_t slot = group*group_width + __builtin_ctz(candidates);
+      if(this->slots[slot].key == pattern){
+        *found = 1;
+        return slot;
+      }
+      candidates = candidates & (candidates - 1);
+    }
+    std::uint32_t empty = this->empty_in_group(group_control);
+    if(empty != 0){
+      *found = 0;
+      return group*group_width + __builtin_ctz(empty);
+    }
+    group = (group + jump) & (groups - 1);
+  }
+  *found = 0;
+  return this->table_size;
+}
+
+//This function checks the load factor, and if the threshold has been surpassed then it
+//doubles the table and moves the slots to the new one. Since all keys are different
+//the first empty slot of each probe sequence is taken.
+void Swiss_Table::check_fill_rate(){
+  if((this->stored_elements + 1) > (this->table_size/8)*7){
+    swiss_slot *old_slots = this->slots;
+    std::int8_t *old_control = this->control;
+    std::size_t old_size = this->table_size;
+    this->allocate_table(2*old_size);
+    bool found = 0;
+    for(std::size_t i = 0; i < old_size; i++){
+      if(old_control[i] != empty_control){
+        std::size_t hash = this->hash_function(old_slots[i].key);
+        std::size_t slot = this->find_or_free_slot(old_slots[i].key, hash, &found);
+        this->control[slot] = (std::int8_t)(hash & 0x7F);
+        this->slots[slot].key.swap(old_slots[i].key);
+        this->slots[slot].text_position.swap(old_slots[i].text_position);
+      }
+    }
+    delete[] old_slots;
+    delete[] old_control;
+  }
+}
+
+//Insertion function, works just like the one of the Hash_Table: if the pattern was not
+//in the table the slot is given the vectors to store the values per text, and the fingerprint
+//of the pattern is written to the control byte of the slot.
+void Swiss_Table::insert(std::string pattern, std::size_t value, int text_index){
+  this->check_fill_rate();
+  std::size_t hash = this->hash_function(pattern);
+  bool found = 0;
+  std::size_t slot = this->find_or_free_slot(pattern, hash, &found);
+  if(!found){
+    this->control[slot] = (std::int8_t)(hash & 0x7F);
+    this->slots[slot].key = pattern;
+    this->slots[slot].text_position.push_back(std::vector<std::size_t> {});
+    this->slots[slot].text_position.push_back(std::vector<std::size_t> {});
+    this->stored_elements++;
+  }
+  this->slots[slot].text_position[text_index].push_back(value);
+}
+
+//Deletes the slot and control arrays.
+void Swiss_Table::delete_data(){
+  delete[] this->slots;
+  delete[] this->control;
+}
+
+//Searches for the pattern, returns its slot or table_size if it is not in the table.
+std::size_t Swiss_Table::search(const std::string &pattern){
+  bool found = 0;
+  std::size_t slot = this->find_or_free_slot(pattern, this->hash_function(pattern), &found);
+  if(found){
+    return slot;
+  }
+  return this->table_size;
+}
+
+//Returns the key stored at a specified slot.
+std::string Swiss_Table::key_in_slot(std::size_t slot){
+  return this->slots[slot].key;
+}
+
+//Prints all the values stored at a given slot, for a given text.
+void Swiss_Table::print_positions(std::size_t slot, int text_index){
+  for(int i = 0; i < this->slots[slot].text_position[text_index].size(); i++){
+    std::cout << this->slots[slot].text_position[text_index][i] << ", ";
+  }
+}
+
+//Reports whether the pattern is in the table.
+//If print is enabled prints information pertaining to the values associated
+//to the pattern in the given text.
+bool Swiss_Table::search_report(std::string pattern, int text_index, int print){
+  std::size_t slot = this->search(pattern);
+  if(print){
+    std::cout << pattern << " found in slot " << slot << " with " << this->slots[slot].text_position[text_index].size() << " occurences: ";
+    this->print_positions(slot, text_index);
+    std::cout << std::endl;
+  }
+  return slot != this->table_size;
+}
+
+//Computes the total size used by a slot.
+std::size_t Swiss_Table::slot_size(const swiss_slot &slot){
+  std::size_t size = sizeof(swiss_slot);
+  if(slot.text_position.size() > 0){
+    size = size + slot.key.capacity();
+    size = size + slot.text_position.capacity()*sizeof(std::vector<std::size_t>);
+    size = size + (slot.text_position[0].capacity() + slot.text_position[1].capacity())*sizeof(std::size_t);
+  }
+  return size;
+}
+
+//Returns the size of the structure, in bytes. Includes one control byte per slot.
+std::size_t Swiss_Table::structure_size(){
+  std::size_t size = sizeof(Swiss_Table) + this->name.capacity()*sizeof(char) + this->table_size*sizeof(std::int8_t);
+  for(std::size_t i = 0; i <= this->table_size; i++){
+    size = size + this->slot_size(this->slots[i]);
+  }
+  return size;
+}
+
+//Returns all occurences of the pattern, for each text.
+std::vector<std::size_t> Swiss_Table::occurences(std::string pattern){
+  std::size_t slot = this->search(pattern);
+  return std::vector<std::size_t> {this->slots[slot].text_position[0].size(), this->slots[slot].text_position[1].size()};
+}
+
+//Simple example of usage.
+void example_1_swiss(){
+  Swiss_Table *Table = new Swiss_Table();
+  Table->insert("SOME", 0, 0);
+  Table->insert("ABACUS", 4, 0);
+  Table->insert("SOMETHING", 16, 0);
+  Table->insert("B", 50, 0);
+  Table->insert("SOME", 40, 0);
+
+  Table->search_report("SOME",0, 1);
+  Table->search_report("ABACUS",0, 1);
+  Table->search_report("SOMETHING",0, 1);
+  Table->search_report("B",0, 1);
+  Table->search_report("SOMERSET",0, 1);
+
+  Table->delete_data();
+  delete Table;
+}
+
+//UNCOMMENT MAIN TO TEST EXAMPLES IN STANDALONE FASHION
+// int main(){
+//   example_1_swiss();
+//   return 0;
+// }
@@ -0,0 +1,52 @@
+#ifndef __SW_H_INCLUDED__
+#define __SW_H_INCLUDED__
+
+#include <string>
+#include <iostream>
+#include <functional>
+#include <vector>
+#include <cstdint>
+
+//A Swiss_Table keeps the same kind of slots as the Hash_Table (a key and the values per text),
+//but next to them it keeps an array of control bytes, one per slot. A control byte is either
+//empty_control or the 7 lowest bits of the hash of the key stored in the slot (its fingerprint).
+struct swiss_slot{
+  std::string key;
+  std::vector<std::vector<std::size_t>> text_position;
+};
+
+//Swiss_Table class declaration, exposes the same interface as the Hash_Table so that
+//it can be used in the experiment templates.
+class Swiss_Table{
+public:
+  Swiss_Table();
+  void insert(std::string pattern, std::size_t value, int text_index);
+  std::size_t search(const std::string &pattern);
+  void delete_data();
+  std::string key_in_slot(std::size_t slot);
+  bool search_report(std::string pattern, int text_index, int print);
+  std::string get_name(){return this->name;}
+  std::size_t structure_size();
+  double get_fill();
+  double extra_measurement(){return this->get_fill();}
+  std::vector<std::size_t> occurences(std::string pattern);
+private:
+  static const std::size_t group_width = 16;
+  static const std::int8_t empty_control = -128;
+  swiss_slot *slots;
+  std::int8_t *control;
+  std::size_t table_size;
+  std::size_t stored_elements;
+  std::string name = "SWISS";
+
+  std::hash<std::string> hash_function;
+  std::uint32_t match_group(const std::int8_t *group, std::int8_t fingerprint);
+  std::uint32_t empty_in_group(const std::int8_t *group);
+  std::size_t find_or_free_slot(const std::string &pattern, std::size_t hash, bool *found);
+  void allocate_table(std::size_t size);
+  void check_fill_rate();
+  std::size_t slot_size(const swiss_slot &slot);
+  void print_positions(std::size_t slot, int text_index);
+};
+
+#endif
@@ -1,137 +1,303 @@
 #include "ternary.hpp"
 
-//Class constructor, we merely need to initialize the root as nullptr;
+//Class constructor, the tree starts empty.
 Ternary_Search_Tree::Ternary_Search_Tree(){
-  this->root = nullptr;
 }
 
-//This method creates a node to store the character. All the fields are declared
-//nullptr because the insertion function first creates a node and then fills it
-//up with the corresponding information.
-//We add the char 1 to all patterns before inserting them, which is lexicographically
-//smaller than any char used in the texts or the randomly generated strings.
-//If the node is to hold this pattern, refered to henceforth as lesser_character,
-//then it will need text_position to contain the corresponding vectors to each text,
-//so we can store the values associated with the key.
-//The counts_as_lesser field is necessary because it could be the case that we
-//would want to insert a node containing the lesser_character at a point where
-//there is already another node (e.g: Say we inserted the pattern re + lesser character,
-//we would have a node with 'r', its equal child would be 'e', and 'e' would have
-//an equal child 'lesser_character'. If we, then, inserted the pattern r + lesser_character)
-//we would probe the tree, go to the node with r, advance to its equal child, where
-//we would want to insert the lesser_pattern node, but e is already there, so we need
-//to equip nodes with the plasticity to act as lesser_character nodes simultaneously.
-struct ternary_node* Ternary_Search_Tree::new_node(std::string character){
-  struct ternary_node* new_node = new struct ternary_node();
-  new_node->lesser_child = nullptr;
-  new_node->equal_child = nullptr;
-  new_node->greater_child = nullptr;
-  new_node->character = character;
-  new_node->counts_as_lesser = 0;
-  if(character == this->lesser_character){
-    new_node->counts_as_lesser = 1;
-    new_node->text_position.push_back(std::vector<std::size_t> {});
-    new_node->text_position.push_back(std::vector<std::size_t> {});
+//Constructor for a tree that keeps itself balanced under any insertion order: the nodes that branch on the same
+//character (linked by their lesser and greater children) are kept as a treap, so their depth is logarithmic in
+//their number with high probability, even when the keys are inserted sorted.
+//If root_bytes is 1 or 2 the tree is hybrid: its root is a table indexed by that many characters, which replaces
+//the comparisons of the first levels, those that every search goes through, with a single access.
+Ternary_Search_Tree::Ternary_Search_Tree(bool balanced, int root_bytes){
+  this->balanced = balanced;
+  this->root_bytes = std::min(std::max(root_bytes, 0), 2);
+  if(balanced){
+    this->name = this->name + "_TREAP";
+  }
+  if(this->root_bytes == 1){
+    this->name = this->name + "_R";
+  }else if(this->root_bytes == 2){
+    this->name = this->name + "_R2";
   }
-  return new_node;
 }
 
-//This method probes a node to see if its character corresponds to the first character
-//of the pattern. If it is and the only remaining character is lesser_character, we
-//check whether the equal child exists to create it if necessary, or if it acts as
-//a lesser_character, in which case we just add the value. If the node exists, but
-//is not acting as lesser_character (because it holds some other character) we enable
-//it to act as a lesser_character node and add the value after creating the text vectors.
-//In case more of the pattern remains, we insert the pattern, without the first character,
-//to the equal_child.
-
-//If the character is greater or lesser we insert the whole pattern again to the greater_child
-//or lesser_child, respectively.
-
-//Note that when we insert the pattern to a child it might be the case that the child
-//is nullptr. If this is the case we create the node and reinsert the pattern to the new node.
-void Ternary_Search_Tree::insert_to_node(std::string pattern, struct ternary_node** node, int text_index, std::size_t value){
-  if ((*node) == nullptr){
-    (*node) = this->new_node(pattern.substr(0,1));
-    this->insert_to_node(pattern, node, text_index, value);
-    return;
+//Returns the entry of the root table of a non empty pattern: the one of its first character if the table has 1 byte
+//or the pattern has a single character, otherwise the one of its first two characters, after the 256 single ones.
+std::size_t Ternary_Search_Tree::table_index(const std::string &pattern){
+  if(this->root_bytes == 1 || pattern.size() == 1){
+    return (unsigned char)pattern[0];
   }
-  if (pattern.substr(0,1) == (*node)->character){
-    std::string remaining_characters = pattern.substr(1,pattern.size()-1);
-    if (remaining_characters == this->lesser_character){
+  return 256 + 256*(unsigned char)pattern[0] + (unsigned char)pattern[1];
+}
 
-      if(((*node)->equal_child) == nullptr){
-        (*node)->equal_child = this->new_node(remaining_characters);
-      }
-      if((*node)->equal_child->counts_as_lesser){
-      (*node)->equal_child->text_position[text_index].push_back(value);
-      }else{
-        (*node)->equal_child->counts_as_lesser = 1;
-        (*node)->equal_child->text_position.push_back(std::vector<std::size_t> {});
-        (*node)->equal_child->text_position.push_back(std::vector<std::size_t> {});
-        (*node)->equal_child->text_position[text_index].push_back(value);
-      }
-      return;
+//Returns a random priority for a node of the treap, from a xorshift generator.
+std::uint16_t Ternary_Search_Tree::random_priority(){
+  this->random_state = this->random_state ^ (this->random_state << 13);
+  this->random_state = this->random_state ^ (this->random_state >> 17);
+  this->random_state = this->random_state ^ (this->random_state << 5);
+  return this->random_state >> 16;
+}
+
+//Rotates the node that node points to above its ancestors in the treap while their priority is lower. path holds
+//the fields that point to those ancestors, from the first node that branches on the same character, and the node
+//is a leaf of the treap, so a rotation moves its only subtree, on the side of the parent, to the parent. Returns the
+//field that points to the node once it is in place.
+struct ternary_node** Ternary_Search_Tree::rotate_up(struct ternary_node** path[], std::size_t path_size, struct ternary_node** node){
+  struct ternary_node* child = *node;
+  while(path_size > 0 && (*path[path_size - 1])->priority < child->priority){
+    node = path[path_size - 1];
+    path_size--;
+    struct ternary_node* parent = *node;
+    if(parent->lesser_child == child){
+      parent->lesser_child = child->greater_child;
+      child->greater_child = parent;
     }else{
-      this->insert_to_node(remaining_characters, &((*node)->equal_child), text_index, value);
+      parent->greater_child = child->lesser_child;
+      child->lesser_child = parent;
     }
-  }else if(pattern.substr(0,1) < (*node)->character){
-    this->insert_to_node(pattern, &((*node)->lesser_child), text_index, value);
-  }else{
-    this->insert_to_node(pattern, &((*node)->greater_child), text_index, value);
+    *node = child;
   }
+  return node;
 }
 
-//Insertion method that checks whether the root is nullptr and creates it if necessary,
-//if it is not nullptr then uses the previous method to insert from the root.
-void Ternary_Search_Tree::insert(std::string pattern, std::size_t value, int text_index){
-  pattern = pattern + this->lesser_character;
-  if (this->root == nullptr && pattern != this->lesser_character){
-    *(&(this->root)) = this->new_node(pattern.substr(0,1));
-    this->insert_to_node(pattern,&(this->root), text_index, value);
-    return;
+//This method takes a node from the arena to store the character, with no children. It is not
+//terminal until a key that ends at it is inserted.
+struct ternary_node* Ternary_Search_Tree::new_node(unsigned char character){
+  struct ternary_node* new_node = this->node_arena.allocate();
+  new_node->character = character;
+  return new_node;
+}
+
+//Adds a value to the key that ends at node, making the node terminal (with a new posting) if it was not.
+void Ternary_Search_Tree::add_value(struct ternary_node* node, std::size_t value, int text_index){
+  if(!node->is_terminal){
+    node->is_terminal = 1;
+    node->posting = this->postings.add_key();
   }
-  this->insert_to_node(pattern, &(this->root), text_index, value);
+  this->postings.add_value(node->posting, value, text_index);
 }
 
-//Deletes all the nodes in the tree.
-void Ternary_Search_Tree::delete_node(struct ternary_node* node){
-  if (node != nullptr){
-  this->delete_node(node->lesser_child);
-  this->delete_node(node->equal_child);
-  this->delete_node(node->greater_child);
-  delete node;
+//Inserts a pattern, walking the tree from the root with the index of the current character of the pattern.
+//If the character of the node is greater or lesser we move to the lesser_child or greater_child, respectively,
+//with the same character. If it is the same we move to the equal_child with the next character, unless it was
+//the last one: then the key ends at this node, which is marked as terminal and takes the value.
+//Whenever the child we move to is nullptr the node is created there, with the current character, so the walk
+//keeps a pointer to the field that points to the current node.
+//If the tree is balanced the fields followed since the last equal_child are kept in path (at most 255, one per
+//other character), and a new node is rotated up with them to its place in the treap.
+void Ternary_Search_Tree::insert(const std::string &pattern, std::size_t value, int text_index){
+  if(pattern.empty()){
+    this->add_value(&this->empty_key, value, text_index);
+    return;
+  }
+  struct ternary_node** node = &this->root;
+  struct ternary_node** path[256];
+  std::size_t path_size = 0;
+  std::size_t depth = 0;
+  if(this->root_bytes > 0){
+    if(this->root_table.empty()){
+      this->root_table.resize(this->root_bytes == 1 ? 256 : 256 + 65536, ternary_node());
+    }
+    struct ternary_node* entry = &this->root_table[this->table_index(pattern)];
+    depth = std::min(pattern.size(), (std::size_t)this->root_bytes);
+    if(depth == pattern.size()){
+      this->add_value(entry, value, text_index);
+      return;
+    }
+    node = &(entry->equal_child);
+  }
+  while(1){
+    unsigned char character = pattern[depth];
+    if((*node) == nullptr){
+      (*node) = this->new_node(character);
+      if(this->balanced){
+        (*node)->priority = this->random_priority();
+        node = this->rotate_up(path, path_size, node);
+      }
+    }
+    if(character < (*node)->character){
+      path[path_size] = node;
+      path_size = path_size + this->balanced;
+      node = &((*node)->lesser_child);
+    }else if(character > (*node)->character){
+      path[path_size] = node;
+      path_size = path_size + this->balanced;
+      node = &((*node)->greater_child);
+    }else{
+      depth++;
+      if(depth == pattern.size()){
+        this->add_value(*node, value, text_index);
+        return;
+      }
+      path_size = 0;
+      node = &((*node)->equal_child);
+    }
   }
 }
 
-//Common interface of the 3 structures
-void Ternary_Search_Tree::delete_data(){
-  this->delete_node(this->root);
+//Makes node terminal, with a posting that holds the values of its key for both texts.
+void Ternary_Search_Tree::load_values(struct ternary_node* node, const std::vector<std::vector<std::size_t>> &values){
+  node->is_terminal = 1;
+  node->posting = this->postings.add_key();
+  for(std::size_t text = 0; text < values.size(); text++){
+    for(std::size_t i = 0; i < values[text].size(); i++){
+      this->postings.add_value(node->posting, values[text][i], text);
+    }
+  }
 }
 
-//Searches for a pattern in the given node. Navigates the tree just like insertion does.
-struct ternary_node* Ternary_Search_Tree::node_search(std::string pattern, struct ternary_node* node){
+//Builds the nodes that branch on the character at depth of the keys in [first, last) (taken in the order given by
+//order), which share their first depth characters and are longer than depth. A single key is just a chain of equal
+//children. Otherwise the start of every group of keys with the same character is found, and build_siblings makes a
+//balanced tree of the groups. The starts are kept in level_starts[depth], since only one level per depth is being
+//built at a time, so their memory is reused across levels.
+struct ternary_node* Ternary_Search_Tree::build_level(const std::vector<std::string> &keys, const std::vector<std::size_t> &order, const std::vector<std::vector<std::vector<std::size_t>>> &key_values, std::size_t first, std::size_t last, std::size_t depth){
+  if(last - first == 1){
+    const std::string &key = keys[order[first]];
+    struct ternary_node* chain = this->new_node(key[depth]);
+    struct ternary_node* node = chain;
+    node->priority = 0xFFFF;
+    for(depth++; depth < key.size(); depth++){
+      node->equal_child = this->new_node(key[depth]);
+      node = node->equal_child;
+      node->priority = 0xFFFF;
+    }
+    this->load_values(node, key_values[order[first]]);
+    return chain;
+  }
+  std::vector<std::size_t> &starts = this->level_starts[depth];
+  starts.clear();
+  for(std::size_t i = first; i < last; i++){
+    if(i == first || keys[order[i]][depth] != keys[order[i - 1]][depth]){
+      starts.push_back(i);
+    }
+  }
+  starts.push_back(last);
+  return this->build_siblings(keys, order, key_values, starts, 0, starts.size() - 1, depth, 0);
+}
 
-  if (node == nullptr){
+//Builds the groups of keys in [first_group, last_group) as a tree of lesser and greater children. The root is the
+//group that holds the median key, so both sides get half of the keys, and each side is built the same way. The key
+//that ends at the node, if any, is the first of its group (it is the shortest), and the rest of the group is built
+//one character deeper as the equal_child. level is the depth of the node among its siblings, which gives it a
+//priority that keeps the heap order of the treap, in case more keys are inserted in a balanced tree.
+struct ternary_node* Ternary_Search_Tree::build_siblings(const std::vector<std::string> &keys, const std::vector<std::size_t> &order, const std::vector<std::vector<std::vector<std::size_t>>> &key_values, const std::vector<std::size_t> &starts, std::size_t first_group, std::size_t last_group, std::size_t depth, int level){
+  if(first_group == last_group){
     return nullptr;
   }
+  std::size_t median = (starts[first_group] + starts[last_group])/2;
+  std::size_t group = std::upper_bound(starts.begin() + first_group, starts.begin() + last_group, median) - starts.begin() - 1;
+  std::size_t key = starts[group];
+  struct ternary_node* node = this->new_node(keys[order[key]][depth]);
+  node->priority = 0xFFFF - level;
+  node->lesser_child = this->build_siblings(keys, order, key_values, starts, first_group, group, depth, level + 1);
+  node->greater_child = this->build_siblings(keys, order, key_values, starts, group + 1, last_group, depth, level + 1);
+  if(keys[order[key]].size() == depth + 1){
+    this->load_values(node, key_values[order[key]]);
+    key++;
+  }
+  if(key < starts[group + 1]){
+    node->equal_child = this->build_level(keys, order, key_values, key, starts[group + 1], depth + 1);
+  }
+  return node;
+}
 
-  if (node->character == pattern.substr(0,1)){
-    if (pattern.size() == 2 && node->equal_child->counts_as_lesser){
-      return node->equal_child;
+//Replaces the contents of the tree with the keys of a dictionary (which must be different) and their values for each
+//text, building a balanced tree in a single pass over them instead of inserting them one by one. The keys should
+//come sorted lexicographically, otherwise they are sorted first.
+void Ternary_Search_Tree::bulk_load(const std::vector<std::string> &sorted_keys, const std::vector<std::vector<std::vector<std::size_t>>> &key_values){
+  this->delete_data();
+  std::vector<std::size_t> order(sorted_keys.size());
+  for(std::size_t i = 0; i < order.size(); i++){
+    order[i] = i;
+  }
+  if(!std::is_sorted(sorted_keys.begin(), sorted_keys.end())){
+    std::sort(order.begin(), order.end(), [&sorted_keys](std::size_t a, std::size_t b){
+      return sorted_keys[a] < sorted_keys[b];
+    });
+  }
+  std::size_t first = 0;
+  if(!order.empty() && sorted_keys[order[0]].empty()){
+    this->load_values(&this->empty_key, key_values[order[0]]);
+    first = 1;
+  }
+  if(first < order.size()){
+    std::size_t max_length = 0;
+    for(std::size_t i = 0; i < sorted_keys.size(); i++){
+      max_length = std::max(max_length, sorted_keys[i].size());
     }
-    return this->node_search(pattern.substr(1,pattern.size()-1), node->equal_child);
-  }else if(node->character > pattern.substr(0,1)){
-    return this->node_search(pattern, node->lesser_child);
-  }else{
-    return this->node_search(pattern, node->greater_child);
+    this->level_starts.resize(max_length);
+    if(this->root_bytes == 0){
+      this->root = this->build_level(sorted_keys, order, key_values, first, order.size(), 0);
+    }else{
+      //The keys that share the first root_bytes characters are consecutive, the one made of those characters first.
+      this->root_table.resize(this->root_bytes == 1 ? 256 : 256 + 65536, ternary_node());
+      std::size_t i = first;
+      while(i < order.size()){
+        const std::string &key = sorted_keys[order[i]];
+        struct ternary_node* entry = &this->root_table[this->table_index(key)];
+        if(key.size() <= (std::size_t)this->root_bytes){
+          this->load_values(entry, key_values[order[i]]);
+          i++;
+          continue;
+        }
+        std::size_t last = i + 1;
+        while(last < order.size() && sorted_keys[order[last]].compare(0, this->root_bytes, key, 0, this->root_bytes) == 0){
+          last++;
+        }
+        entry->equal_child = this->build_level(sorted_keys, order, key_values, i, last, this->root_bytes);
+        i = last;
+      }
+    }
+    std::vector<std::vector<std::size_t>>().swap(this->level_starts);
   }
+}
 
+//Common interface of the 3 structures. The nodes are released with the chunks of the arena, without
+//visiting them.
+void Ternary_Search_Tree::delete_data(){
+  this->node_arena.release_all();
+  this->root = nullptr;
+  std::vector<struct ternary_node>().swap(this->root_table);
+  this->empty_key.is_terminal = 0;
+  this->postings.clear();
 }
 
-//Searches the pattern in the tree from the root.
-struct ternary_node* Ternary_Search_Tree::search(std::string pattern){
-  return this->node_search(pattern + this->lesser_character, this->root);
+//Searches the pattern in the tree from the root, navigating the tree just like insertion does. Returns the
+//node where the pattern ends if it is a key of the tree, otherwise nullptr.
+struct ternary_node* Ternary_Search_Tree::search(const std::string &pattern){
+  if(pattern.empty()){
+    return this->empty_key.is_terminal ? &this->empty_key : nullptr;
+  }
+  struct ternary_node* node = this->root;
+  std::size_t depth = 0;
+  if(this->root_bytes > 0){
+    if(this->root_table.empty()){
+      return nullptr;
+    }
+    struct ternary_node* entry = &this->root_table[this->table_index(pattern)];
+    depth = std::min(pattern.size(), (std::size_t)this->root_bytes);
+    if(depth == pattern.size()){
+      return entry->is_terminal ? entry : nullptr;
+    }
+    node = entry->equal_child;
+  }
+  while(node != nullptr){
+    unsigned char character = pattern[depth];
+    if(character < node->character){
+      node = node->lesser_child;
+    }else if(character > node->character){
+      node = node->greater_child;
+    }else{
+      depth++;
+      if(depth == pattern.size()){
+        return node->is_terminal ? node : nullptr;
+      }
+      node = node->equal_child;
+    }
+  }
+  return nullptr;
 }
 
 //Finds the depth of the tree rooted at node.
@@ -145,6 +311,51 @@ int Ternary_Search_Tree::find_depth(struct ternary_node* node){
   return 0;
 }
 
+//Returns the depth of the tree, the most nodes a search visits. In hybrid mode the root table counts as one.
+int Ternary_Search_Tree::max_depth(){
+  if(this->root_bytes == 0){
+    return this->find_depth(this->root);
+  }
+  int depth = 0;
+  for(std::size_t i = 0; i < this->root_table.size(); i++){
+    depth = std::max(depth, 1 + this->find_depth(this->root_table[i].equal_child));
+  }
+  return depth;
+}
+
+//Adds the nodes of the tree rooted at node, which is at the given depth, to the distribution.
+void Ternary_Search_Tree::count_depths(struct ternary_node* node, std::size_t depth, std::vector<std::size_t> &distribution){
+  while(node != nullptr){
+    if(distribution.size() <= depth){
+      distribution.resize(depth + 1, 0);
+    }
+    distribution[depth]++;
+    this->count_depths(node->lesser_child, depth + 1, distribution);
+    this->count_depths(node->greater_child, depth + 1, distribution);
+    node = node->equal_child;
+    depth++;
+  }
+}
+
+//Returns how many nodes there are at every depth: the i-th number counts the nodes that a search reaches after
+//visiting i nodes (the root is the only one at 0). In hybrid mode the root table counts as the first visit, the
+//entries themselves are not counted.
+std::vector<std::size_t> Ternary_Search_Tree::depth_distribution(){
+  std::vector<std::size_t> distribution;
+  this->count_depths(this->root, 0, distribution);
+  for(std::size_t i = 0; i < this->root_table.size(); i++){
+    this->count_depths(this->root_table[i].equal_child, 1, distribution);
+  }
+  return distribution;
+}
+
+//Returns the number of nodes, the bytes they take and the average number of characters in a node, which is
+//always 1 (the Compressed_Ternary_Search_Tree reports the same measures). The root table is not counted.
+std::vector<double> Ternary_Search_Tree::node_cost(){
+  std::size_t nodes = this->node_arena.allocated();
+  return std::vector<double> {(double)nodes, (double)(nodes*sizeof(struct ternary_node)), nodes == 0 ? 0.0 : 1.0};
+}
+
 //Prints the contents of a node.
 void Ternary_Search_Tree::print_node_contents(struct ternary_node* node, std::string offset, int depth){
   if (depth == 0){
@@ -164,36 +375,42 @@ void Ternary_Search_Tree::print_node_contents(struct ternary_node* node, std::st
 }
 
 //Prints a tree level by level. Not as pretty as the method for Patricia_Tree, but
-//less involved.
+//less involved. In hybrid mode the tree of every entry of the root table that has one is printed.
 void Ternary_Search_Tree::print_tree(){
-  std::string offset = "                                                        ";
-  struct ternary_node *current = this->root;
-  int depth = this->find_depth(this->root);
-  std::cout << "printing tree of depth " << depth << std::endl;
-  for(int d = 0; d < depth; d++){
-    std::cout << "depth " << d << std::endl;
-    this->print_node_contents(current, offset, d);
-    std::cout << std::endl;
-    offset = offset.substr(0,offset.size()/2 -2);
+  std::vector<struct ternary_node*> trees = {this->root};
+  std::vector<std::string> prefixes = {""};
+  for(std::size_t i = 0; i < this->root_table.size(); i++){
+    if(this->root_table[i].equal_child != nullptr){
+      trees.push_back(this->root_table[i].equal_child);
+      prefixes.push_back(this->root_bytes == 1 ? std::string(1, (char)i) : std::string {(char)((i - 256)/256), (char)((i - 256)%256)});
+    }
   }
-}
-
-//Prints the values associated with the key that the node represents, for a given text.
-void Ternary_Search_Tree::print_positions(struct ternary_node* node, int text_index){
-  for(int i = 0; i < node->text_position[text_index].size(); i++){
-    std::cout << node->text_position[text_index][i] << ", ";
+  for(std::size_t tree = 0; tree < trees.size(); tree++){
+    if(tree > 0){
+      std::cout << "tree of the entry " << prefixes[tree] << std::endl;
+    }
+    std::string offset = "                                                        ";
+    struct ternary_node *current = trees[tree];
+    int depth = this->find_depth(current);
+    std::cout << "printing tree of depth " << depth << std::endl;
+    for(int d = 0; d < depth; d++){
+      std::cout << "depth " << d << std::endl;
+      this->print_node_contents(current, offset, d);
+      std::cout << std::endl;
+      offset = offset.substr(0,offset.size()/2 -2);
+    }
   }
 }
 
 //Performs a search in the Tree for the pattern and reports if it finds it or not.
 //If print is enabled it gives the values associated with the key for a given text.
-bool Ternary_Search_Tree::search_report(std::string pattern, int text_index, int print){
+bool Ternary_Search_Tree::search_report(const std::string &pattern, int text_index, int print){
   struct ternary_node* s = this->search(pattern);
   if (s != nullptr){
     if (print){
     std::cout << pattern << " has been found >> ";
-    std::cout << "according to the node it has " << s->text_position[text_index].size() << " ocurrences at slots ";
-    this->print_positions(s,text_index);
+    std::cout << "according to the node it has " << this->postings.count(s->posting, text_index) << " ocurrences at slots ";
+    this->postings.print(s->posting, text_index);
     std::cout << std::endl;
     }
     return 1;
@@ -201,38 +418,22 @@ bool Ternary_Search_Tree::search_report(std::string pattern, int text_index, int
   return 0;
 }
 
-//Returns the total size spent by the node to store the vectors of values.
-std::size_t Ternary_Search_Tree::pattern_occurences_cost(std::vector<std::vector<std::size_t>> occurences){
-  if(occurences.size() > 0){
-    return sizeof(std::size_t)*(occurences[0].capacity() + occurences[1].capacity());
-  }
-  return 0;
-}
-
-//Computes the cost of the subtree rooted at node.
-std::size_t Ternary_Search_Tree::node_cost(struct ternary_node* node){
-  if(node != nullptr){
-    std::size_t lesser = this->node_cost(node->lesser_child);
-    std::size_t equal = this->node_cost(node->equal_child);
-    std::size_t greater = this->node_cost(node->greater_child);
-    return node->text_position.capacity()*sizeof(std::vector<std::size_t>) + sizeof(struct ternary_node) + lesser + equal + greater + this->pattern_occurences_cost(node->text_position) + node->character.capacity()*sizeof(char); // Node size is 57 bytes, but 64 due to padding.
-  }
-  return 0;
-}
-
-//Returns the total structure size in bytes.
+//Returns the total structure size in bytes: the chunks of the node arena (nodes take 32 bytes), the root table
+//in hybrid mode and the postings table.
 std::size_t Ternary_Search_Tree::structure_size(){
-  std::size_t base = sizeof(Ternary_Search_Tree) + this->name.capacity()*sizeof(char);
-  if(this->root != nullptr){
-    return this->node_cost(this->root) + base;
-  }
-  return base;
+  std::size_t size = sizeof(Ternary_Search_Tree) + this->name.capacity()*sizeof(char) + this->node_arena.footprint();
+  size = size + this->root_table.capacity()*sizeof(struct ternary_node);
+  size = size + this->postings.structure_size();
+  return size;
 }
 
 //Returns all occurences of the pattern, for each text.
-std::vector<std::size_t> Ternary_Search_Tree::occurences(std::string pattern){
+std::vector<std::size_t> Ternary_Search_Tree::occurences(const std::string &pattern){
   struct ternary_node* s = this->search(pattern);
-  return std::vector<std::size_t> {s->text_position[0].size(), s->text_position[1].size()};
+  if(s == nullptr){
+    return std::vector<std::size_t> {0, 0};
+  }
+  return std::vector<std::size_t> {this->postings.count(s->posting, 0), this->postings.count(s->posting, 1)};
 }
 
 //Simple, plainly laid out, example of Tree usage.
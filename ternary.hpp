@@ -4,48 +4,96 @@
 #include <string>
 #include <iostream>
 #include <algorithm>
+#include <vector>
+#include <cstdint>
+#include "arena.hpp"
+#include "postings.hpp"
 
 //At the core of a ternary search tree is a ternary node:
 //- 3 pointers to children
-//- 1 string to store the character (could be a char, which would save us some good 7 bits, but it'd imply a casting)
-//- 1 vector of vectors to hold the values for each text
-//- 1 boolean that indicates whether the node acts as a lesser_character node
+//- 1 byte with the character of the node
+//- 1 flag that tells whether a key ends at the node (the node of the last character of the key)
+//- 1 index to the values of that key in the postings table of the tree
+//- 1 priority, only used when the tree is balanced as a treap
+//So a node takes 32 bytes, the values are only paid for by the nodes where a key ends.
 struct ternary_node{
   struct ternary_node* lesser_child;
   struct ternary_node* equal_child;
   struct ternary_node* greater_child;
-  std::string character;
-  std::vector<std::vector<std::size_t>> text_position;
-  bool counts_as_lesser;
+  std::uint32_t posting;
+  unsigned char character;
+  bool is_terminal;
+  std::uint16_t priority;
 };
 
 //Ternary_Search_Tree class, indicates which methods are public and which are private.
 class Ternary_Search_Tree{
 public:
   Ternary_Search_Tree();
-  void insert(std::string pattern, std::size_t value, int text_index);
-  struct ternary_node* search(std::string pattern);
+  Ternary_Search_Tree(bool balanced, int root_bytes = 0);
+  void insert(const std::string &pattern, std::size_t value, int text_index);
+  void bulk_load(const std::vector<std::string> &sorted_keys, const std::vector<std::vector<std::vector<std::size_t>>> &key_values);
+  struct ternary_node* search(const std::string &pattern);
   void delete_data();
   void print_tree();
-  bool search_report(std::string pattern, int text_index, int print);
+  bool search_report(const std::string &pattern, int text_index, int print);
   std::string get_name(){return this->name;}
   std::size_t structure_size();
-  double extra_measurement(){return this->find_depth(this->root);}
-  std::vector<std::size_t> occurences(std::string pattern);
+  int max_depth();
+  std::vector<std::size_t> depth_distribution();
+  std::vector<double> node_cost();
+  double extra_measurement(){return this->max_depth();}
+  std::vector<std::size_t> occurences(const std::string &pattern);
 private:
-  struct ternary_node *root = new struct ternary_node();
+  struct ternary_node *root = nullptr;
+  //Every node comes from the arena, so delete_data frees them a chunk at a time.
+  Node_Arena<struct ternary_node> node_arena;
+  //The empty key has no character, so it has no place in the tree, it ends at this node instead.
+  struct ternary_node empty_key = {nullptr, nullptr, nullptr, 0, 0, 0, 0};
+  //The values of each key, for both texts.
+  Postings_Table postings;
   std::string name = "TERN";
+  //When balanced, the nodes linked by lesser and greater children (those that branch on the same character of the
+  //keys) form a treap: every new node gets a random priority and is rotated up above the nodes with a lower one.
+  bool balanced = 0;
+  std::uint32_t random_state = 0x9E3779B9;
+  //In hybrid mode (root_bytes is 1 or 2) the root is a table of nodes indexed by the first root_bytes characters of
+  //the keys, as in the TST with an R or R^2 way root of Sedgewick. The key made of those characters ends at its entry,
+  //and the equal_child of the entry is the tree of the rest of the keys that start with them. With 2 bytes the keys
+  //of a single character have their own 256 entries first. The table is allocated with the first key.
+  int root_bytes = 0;
+  std::vector<struct ternary_node> root_table;
+  //Only used by bulk_load, the starts of the groups of keys of the level being built at every depth.
+  std::vector<std::vector<std::size_t>> level_starts;
 
-  void delete_node(struct ternary_node* node);
-  void insert_to_node(std::string pattern, struct ternary_node** node, int text_index, std::size_t value);
-  struct ternary_node* node_search(std::string pattern, struct ternary_node* node);
   int find_depth(struct ternary_node* node);
   void print_node_contents(struct ternary_node* node, std::string offset, int depth);
-  struct ternary_node* new_node(std::string character);
-  std::string lesser_character = std::string(1,(char)1);
-  void print_positions(struct ternary_node* node, int text_index);
-  std::size_t pattern_occurences_cost(std::vector<std::vector<std::size_t>> occurences);
-  std::size_t node_cost(struct ternary_node* node);
+  struct ternary_node* new_node(unsigned char character);
+  void add_value(struct ternary_node* node, std::size_t value, int text_index);
+  std::uint16_t random_priority();
+  std::size_t table_index(const std::string &pattern);
+  void count_depths(struct ternary_node* node, std::size_t depth, std::vector<std::size_t> &distribution);
+  struct ternary_node** rotate_up(struct ternary_node** path[], std::size_t path_size, struct ternary_node** node);
+  void load_values(struct ternary_node* node, const std::vector<std::vector<std::size_t>> &values);
+  struct ternary_node* build_level(const std::vector<std::string> &keys, const std::vector<std::size_t> &order, const std::vector<std::vector<std::vector<std::size_t>>> &key_values, std::size_t first, std::size_t last, std::size_t depth);
+  struct ternary_node* build_siblings(const std::vector<std::string> &keys, const std::vector<std::size_t> &order, const std::vector<std::vector<std::vector<std::size_t>>> &key_values, const std::vector<std::size_t> &starts, std::size_t first_group, std::size_t last_group, std::size_t depth, int level);
+};
+
+//A Ternary_Search_Tree that is always balanced, so that it can be used in the experiment templates.
+class Balanced_Ternary_Search_Tree : public Ternary_Search_Tree{
+public:
+  Balanced_Ternary_Search_Tree() : Ternary_Search_Tree(1){}
+};
+
+//Ternary_Search_Trees whose root is a table over the first character, or the first two characters, of the keys.
+class Hybrid_Ternary_Search_Tree : public Ternary_Search_Tree{
+public:
+  Hybrid_Ternary_Search_Tree() : Ternary_Search_Tree(0, 1){}
+};
+
+class Hybrid_Ternary_Search_Tree_2 : public Ternary_Search_Tree{
+public:
+  Hybrid_Ternary_Search_Tree_2() : Ternary_Search_Tree(0, 2){}
 };
 
 #endif
@@ -226,6 +226,9 @@ std::vector<std::string> random_words_in_text(std::size_t total_words, std::vect
 //Creates and output manager from a filename. It creates a file to store
 //the construction and query times, and another file that separates by pattern length m.
 Output_Manager::Output_Manager(std::string filename){
+  this->max_word_size = -1;
+  this->header_type = 0;
+  this->filename = filename;
   this->output.open(filename+".csv");
   this->output_by_m.open(filename+"_by_m.csv");
 }
@@ -233,6 +236,7 @@ Output_Manager::Output_Manager(std::string filename){
 //Prints the coresponding header to the files.
 //0 for random, 1 for single book and 2 for similarity testing.
 void Output_Manager::set_header_type(int i){
+  this->header_type = i;
   if (i == 0){
     this->output << "Alg, i, |sigma|, " + this->table_columns_1 << std::endl;
     this->output_by_m << "Alg, i, |sigma|, " + this->table_columns_2 << std::endl;
@@ -240,7 +244,7 @@ void Output_Manager::set_header_type(int i){
     this->output << "Alg, text, i, " + this->table_columns_1 << std::endl;
     this->output_by_m << "Alg, text, i, " + this->table_columns_2 << std::endl;
   }else if(i == 2){
-    this->output << "Alg, text1, text2, i, insert_time(s), insert_avg(ms), search_time(s), search_avg(ms), size(bytes), extra, total_time, similarity" << std::endl;
+    this->output << "Alg, text1, text2, i, insert_time(s), insert_avg(ms), search_time(s), search_avg(ms), size(bytes), extra, total_time, similarity, teardown_time(ms)" << std::endl;
   }
 }
 
@@ -265,6 +269,40 @@ void Output_Manager::set_header_variables(std::string text1, std::string text2,
 void Output_Manager::close(){
   this->output.close();
   this->output_by_m.close();
+  if(this->output_statistics.is_open()){
+    this->output_statistics.close();
+  }
+}
+
+//Prints the statistics reported by a structure (such as the probe length histograms of the Hash_Table)
+//to a third file, next to the timing files, which is only created if some structure reports them.
+//Every statistic is a row with the same header as the timing files, the label and its values.
+void Output_Manager::print_statistics(std::string name, std::vector<std::string> labels, std::vector<std::vector<double>> values){
+  if(!this->output_statistics.is_open()){
+    this->output_statistics.open(this->filename + "_statistics.csv");
+    if(this->header_type == 0){
+      this->output_statistics << "Alg, i, |sigma|, statistic, values" << std::endl;
+    }else if(this->header_type == 1){
+      this->output_statistics << "Alg, text, i, statistic, values" << std::endl;
+    }else{
+      this->output_statistics << "Alg, text1, text2, i, statistic, values" << std::endl;
+    }
+  }
+  std::string header = name + ", ";
+  if(this->header_type == 0){
+    header = header + this->i + ", " + this->alphabet_size + ", ";
+  }else if(this->header_type == 1){
+    header = header + this->text + ", " + this->i + ", ";
+  }else{
+    header = header + this->text + ", " + this->text2 + ", " + this->i + ", ";
+  }
+  for(int statistic = 0; statistic < labels.size(); statistic++){
+    std::string text = header + labels[statistic];
+    for(int j = 0; j < values[statistic].size(); j++){
+      text = text + ", " + std::to_string(values[statistic][j]);
+    }
+    this->output_statistics << text << std::endl;
+  }
 }
 
 //Since the information printed only differs at the level of the header
@@ -275,7 +313,9 @@ void Output_Manager::collect_info_and_print(std::string header, int structure){
     text = text + std::to_string(this->data[i][structure]) + ", ";
   }
   text = text + std::to_string(this->data[0][structure] + this->data[2][structure] + this->data[4][structure]) + ", "; //total time = insert_time + search_time + miss_time
-  text = text + std::to_string(this->data[1][structure] + this->data[3][structure] + this->data[5][structure]); //average total time
+  text = text + std::to_string(this->data[1][structure] + this->data[3][structure] + this->data[5][structure]) + ", "; //average total time
+  text = text + std::to_string(this->data[8][structure]) + ", "; //time spent rehashing, included in insert_time
+  text = text + std::to_string(this->data[9][structure]); //time spent in delete_data and delete, not included in the total time
   this->output << text << std::endl;
   for(int size = 1; size < this->data_by_m[0][structure].size(); size++){
     std::string text_by_m = header;
@@ -293,6 +333,7 @@ void Output_Manager::print_similarity(std::string header, int structure){
   for(int i = 0; i < 8; i++){
     text = text + std::to_string(this->data[i][structure]) + ", ";
   }
+  text = text + std::to_string(this->data[8][structure]); //teardown time
   this->output << text << std::endl;
 }
 
@@ -301,9 +342,8 @@ void Output_Manager::print_similarity(std::string header, int structure){
 //1: Used for single book experiments.
 //2: Used for similarity testing.
 void Output_Manager::print(int type){
-  std::vector<std::string> structure_names = {"PATR", "TERN", "HASH"};
-  for(int structure = 0; structure < 3; structure++){
-    std::string header = structure_names[structure] + ", ";
+  for(int structure = 0; structure < this->structure_names.size(); structure++){
+    std::string header = this->structure_names[structure] + ", ";
     if (type == 0){
       header = header + this->i + ", " + this->alphabet_size + ", ";
       this->collect_info_and_print(header, structure);
@@ -319,35 +359,52 @@ void Output_Manager::print(int type){
 
 //Resets the storage vectors.
 void Output_Manager::prepare_vectors(int max_word_size){
+  this->max_word_size = max_word_size;
   this->data = std::vector<std::vector<double>>();
-  for(int i = 0; i < 8; i++){
-    this->data.push_back(std::vector<double>(3, 0.0));
+  for(int i = 0; i < 10; i++){
+    this->data.push_back(std::vector<double>(this->structure_names.size(), 0.0));
   }
 
   if(max_word_size > 0){
     this->data_by_m = std::vector<std::vector<std::vector<double>>>();
     for(int i = 0; i < 4; i++){
       this->data_by_m.push_back(std::vector<std::vector<double>>());
-      for(int j = 0; j < 3; j++){
+      for(int j = 0; j < this->structure_names.size(); j++){
         this->data_by_m[i].push_back(std::vector<double>(max_word_size+1,0.0));
       }
     }
   }
 }
 
+//Returns the column of the data vectors that belongs to the structure called name. PATR, TERN and HASH
+//always take the first 3 columns, any other structure gets a new column (and its own by m vectors) the first
+//time its values are updated, so it is printed after them.
+int Output_Manager::structure_index(std::string name){
+  for(int index = 0; index < this->structure_names.size(); index++){
+    if(this->structure_names[index] == name){
+      return index;
+    }
+  }
+  this->structure_names.push_back(name);
+  for(int i = 0; i < this->data.size(); i++){
+    this->data[i].push_back(0.0);
+  }
+  if(this->max_word_size > 0){
+    for(int i = 0; i < this->data_by_m.size(); i++){
+      this->data_by_m[i].push_back(std::vector<double>(this->max_word_size+1,0.0));
+    }
+  }
+  return this->structure_names.size() - 1;
+}
+
 //This method is given the new_data vector, which adds to the data vector of the manager
 //the new_data_m vector, which contains a vector with the search times of the words present in the structure (by size),
 //and another vector which contains the search miss times of the words not present in the structure (also by size).
 //With this information we update the search and miss times by m, and the average search and miss times by m.
 void Output_Manager::update_values(std::string name, std::vector<double> new_data, std::vector<std::vector<double>> new_data_m, std::vector<std::size_t> words_per_length, std::vector<std::size_t> miss_words_per_size){
-  int index = 0; //for patricia
-  if(name == "TERN"){
-    index = 1;
-  }else if(name == "HASH"){
-    index = 2;
-  }
-  if(new_data.size() != 8){
-    std::cout << "ERROR: ELAPSED TIME VECTOR SIZE MISMATCH, SHOULD BE 8. In new_data.";
+  int index = this->structure_index(name);
+  if(new_data.size() != 10){
+    std::cout << "ERROR: ELAPSED TIME VECTOR SIZE MISMATCH, SHOULD BE 10. In new_data.";
   }
   for(int i = 0; i < new_data.size(); i++){
     this->data[i][index] = this->data[i][index] + new_data[i];
@@ -368,12 +425,7 @@ void Output_Manager::update_values(std::string name, std::vector<double> new_dat
 }
 
 void Output_Manager::update_values(std::string name, std::vector<double> new_data){
-  int index = 0; //for patricia
-  if(name == "TERN"){
-    index = 1;
-  }else if(name == "HASH"){
-    index = 2;
-  }
+  int index = this->structure_index(name);
   for(int i = 0; i < new_data.size(); i++){
     this->data[i][index] = this->data[i][index] + new_data[i];
   }
@@ -389,15 +441,15 @@ void Output_Manager::update_values(std::string name, std::vector<double> new_dat
 
 //Averages the stored values by the number of iterations.
 void Output_Manager::compute_averages(int iterations, int type){ //type 0 for similarity, 1 for the other 2
-  for(int i = 0; i < 8; i++){
-    for(int index = 0; index < 3; index++){
+  for(int i = 0; i < 10; i++){
+    for(int index = 0; index < this->structure_names.size(); index++){
       this->data[i][index] = this->data[i][index]/iterations;
     }
   }
 
   if(type){
     for(int i = 0; i < 4; i++){
-      for(int index = 0; index < 3; index ++){
+      for(int index = 0; index < this->structure_names.size(); index ++){
         for(int m = 1; m < this->data_by_m[i][index].size();m++){
           this->data_by_m[i][index][m] = this->data_by_m[i][index][m]/iterations;
         }
@@ -54,18 +54,24 @@ public:
   void update_values(std::string name, std::vector<double> new_data, std::vector<std::vector<double>> new_data_m, std::vector<std::size_t> words_per_length, std::vector<std::size_t> miss_words_per_size);
   void update_values(std::string name, std::vector<double> new_data);
   void compute_averages(int iterations, int type);
+  void print_statistics(std::string name, std::vector<std::string> labels, std::vector<std::vector<double>> values);
 private:
   void print_similarity(std::string header, int structure);
+  int structure_index(std::string name);
   std::vector<std::string> structure_names = {"PATR", "TERN", "HASH"};
+  int max_word_size;
   std::ofstream output;
   std::ofstream output_by_m;
+  std::ofstream output_statistics;
+  std::string filename;
+  int header_type;
   std::vector<std::vector<double>> data;
   std::vector<std::vector<std::vector<double>>> data_by_m;
   std::string i;
   std::string alphabet_size;
   std::string text;
   std::string text2;
-  std::string table_columns_1 = "insert_time(s), avg_insert(ms), search_time(s), avg_search(ms), miss_time(s), avg_miss(ms), size(bytes), extra, total_time(s), avg_total(ms)";
+  std::string table_columns_1 = "insert_time(s), avg_insert(ms), search_time(s), avg_search(ms), miss_time(s), avg_miss(ms), size(bytes), extra, total_time(s), avg_total(ms), rehash_time(ms), teardown_time(ms)";
   std::string table_columns_2 = "search_time(ms), avg_search_time(ms), miss_time(ms), avg_miss_time(ms), m";
 };
 